@@ -50,6 +50,7 @@
 #include "sql_string.h"   // needed for Rpl_filter
 #include "sql_list.h"     // needed for Rpl_filter
 #include "rpl_filter.h"
+#include "rpl_gtid_index.h"
 
 #include "mysqld.h"
 
@@ -146,6 +147,8 @@ static ulonglong start_position, stop_position;
 #define stop_position_mot  ((my_off_t)stop_position)
 
 static char *start_datetime_str, *stop_datetime_str;
+static rpl_gtid *gtid_index_seek_list= 0;
+static uint32 gtid_index_seek_count= 0;
 static my_time_t start_datetime= 0, stop_datetime= MY_TIME_T_MAX;
 static ulonglong rec_count= 0;
 static MYSQL* mysql = NULL;
@@ -1725,6 +1728,14 @@ that may lead to an endless loop.",
   {"verify-binlog-checksum", 'c', "Verify checksum binlog events.",
    (uchar**) &opt_verify_binlog_checksum, (uchar**) &opt_verify_binlog_checksum,
    0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+  {"gtid-index-seek", OPT_GTID_INDEX_SEEK,
+   "Start reading each local binlog file shortly before the given GTID "
+   "position, a comma-separated list of domain-server-seq GTIDs like "
+   "@@gtid_slave_pos, using the GTID index written by the server with "
+   "--binlog-gtid-index. Events before the position may still be printed. "
+   "Does not apply to a binlog file without usable GTID index, to the file "
+   "--start-position applies to, or with --read-from-remote-server.",
+   0, 0, 0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
   {"rewrite-db", OPT_REWRITE_DB,
    "Updates to a database with a different name than the original. \
 Example: rewrite-db='from->to'.",
@@ -1889,6 +1900,61 @@ static my_time_t convert_str_to_timestamp(const char* str)
 }
 
 
+/*
+  Parse the GTID position of --gtid-index-seek, eg. "0-1-100,1-2-5", into
+  gtid_index_seek_list.
+
+  @return TRUE on syntax error
+*/
+static bool parse_gtid_index_seek(const char *str)
+{
+  uint32 max_count= 1;
+
+  for (const char *p= str; *p; p++)
+    if (*p == ',')
+      max_count++;
+  if (!(gtid_index_seek_list= (rpl_gtid *)
+        alloc_root(&glob_root, max_count * sizeof(rpl_gtid))))
+    return true;
+  gtid_index_seek_count= 0;
+
+  for (;;)
+  {
+    rpl_gtid *gtid= &gtid_index_seek_list[gtid_index_seek_count];
+    ulonglong part[3];
+
+    for (uint i= 0; i < 3; i++)
+    {
+      char *end;
+      while (my_isspace(&my_charset_latin1, *str))
+        str++;
+      if (!my_isdigit(&my_charset_latin1, *str))
+        return true;
+      part[i]= strtoull(str, &end, 10);
+      str= end;
+      if (i < 2 && *str++ != '-')
+        return true;
+    }
+    if (part[0] > UINT_MAX32 || part[1] > UINT_MAX32)
+      return true;
+    gtid->domain_id= (uint32) part[0];
+    gtid->server_id= (uint32) part[1];
+    gtid->seq_no= part[2];
+    for (uint32 i= 0; i < gtid_index_seek_count; i++)
+      if (gtid_index_seek_list[i].domain_id == gtid->domain_id)
+        return true;
+    gtid_index_seek_count++;
+
+    while (my_isspace(&my_charset_latin1, *str))
+      str++;
+    if (!*str)
+      return false;
+    if (*str++ != ',')
+      return true;
+  }
+}
+
+
 extern "C" my_bool
 get_one_option(const struct my_option *opt, const char *argument, const char *)
 {
@@ -1965,6 +2031,15 @@ get_one_option(const struct my_option *opt, const char *argument, const char *)
     }
     opt_base64_output_mode= (enum_base64_output_mode)(val - 1);
     break;
+  case OPT_GTID_INDEX_SEEK:
+    if (parse_gtid_index_seek(argument))
+    {
+      sql_print_error("Bad syntax in gtid-index-seek: expected a "
+                      "comma-separated list of domain-server-seq GTIDs, "
+                      "at most one per domain\n");
+      return 1;
+    }
+    break;
   case OPT_REWRITE_DB:    // db_from->db_to
   {
     /* See also handling of OPT_REPLICATE_REWRITE_DB in sql/mysqld.cc */
@@ -2851,6 +2926,17 @@ static Exit_status dump_local_log_entries(PRINT_EVENT_INFO *print_event_info,
     /* read from normal file */
     if ((fd = my_open(logname, O_RDONLY | O_BINARY, MYF(MY_WME))) < 0)
       return ERROR_STOP;
+    if (gtid_index_seek_count && start_position_mot == BIN_LOG_HEADER_SIZE)
+    {
+      MY_STAT stat;
+      my_off_t seek_pos;
+      if (!my_fstat(fd, &stat, MYF(0)) &&
+          (seek_pos= gtid_index_find_start(logname, (my_off_t) stat.st_size,
+                                           gtid_index_seek_list,
+                                           gtid_index_seek_count)) >
+          BIN_LOG_HEADER_SIZE)
+        start_position= seek_pos;
+    }
     if (init_io_cache(file, fd, 0, READ_CACHE, start_position_mot, 0,
 		      MYF(MY_WME | MY_NABP)))
     {
@@ -3213,4 +3299,5 @@ struct encryption_service_st encryption_handler=
 #include "sql_string.cc"
 #include "sql_list.cc"
 #include "rpl_filter.cc"
+#include "rpl_gtid_index.cc"
 #include "compat56.cc"
@@ -45,5 +45,16 @@ template <typename Type> class Atomic_counter
   operator Type() const { return m_counter.load(std::memory_order_relaxed); }
   Type operator=(const Type val)
   { m_counter.store(val, std::memory_order_relaxed); return val; }
+
+  /** Increment the counter, unless it is 0.
+  @return whether the counter was incremented */
+  bool add_unless_zero()
+  {
+    Type val= m_counter.load(std::memory_order_relaxed);
+    while (val && !m_counter.compare_exchange_weak(val, val + 1,
+                                                   std::memory_order_relaxed))
+    {}
+    return val != 0;
+  }
 };
 #endif /* MY_COUNTER_H_INCLUDED */
@@ -770,6 +770,11 @@ extern my_bool radixsort_is_appliccable(uint n_items, size_t size_of_element);
 extern void my_string_ptr_sort(uchar *base,uint items,size_t size);
 extern void radixsort_for_str_ptr(uchar* base[], uint number_of_elements,
 				  size_t size_of_element,uchar *buffer[]);
+extern my_bool radixsort_msd_is_appliccable(uint n_items,
+                                            size_t size_of_element);
+extern void radixsort_msd_for_str_ptr(uchar* base[], uint number_of_elements,
+                                      size_t size_of_element,
+                                      uchar *buffer[]);
 extern qsort_t my_qsort(void *base_ptr, size_t total_elems, size_t size,
                         qsort_cmp cmp);
 extern qsort_t my_qsort2(void *base_ptr, size_t total_elems, size_t size,
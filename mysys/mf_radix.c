@@ -58,3 +58,86 @@ void radixsort_for_str_ptr(uchar **base, uint number_of_elements, size_t size_of
   next:;
   }
 }
+
+
+/*
+  Most significant digit first radix sort for pointers to fixed length
+  strings. Unlike radixsort_for_str_ptr(), which makes a pass over all
+  elements for every byte, this only looks at as many leading bytes as
+  are needed to tell the elements apart, and sorts small partitions with
+  insertion sort. The sort is stable. Needs an extra buffer of
+  number_of_elements pointers.
+*/
+
+#define MSD_RADIX_INSERTION_SORT 16
+
+my_bool radixsort_msd_is_appliccable(uint n_items, size_t size_of_element)
+{
+  return size_of_element <= 20 && n_items >= 1000;
+}
+
+static void msd_insertion_sort(uchar **base, uint n, size_t offset,
+                               size_t size)
+{
+  uint i;
+  for (i= 1; i < n; i++)
+  {
+    uchar *key= base[i];
+    uint j= i;
+    for (; j && memcmp(base[j-1] + offset, key + offset, size - offset) > 0;
+         j--)
+      base[j]= base[j-1];
+    base[j]= key;
+  }
+}
+
+static void msd_radix_sort(uchar **base, uint n, size_t offset, size_t size,
+                           uchar **buffer)
+{
+  uint32 end[256];
+  uint i, b, start;
+
+  for (;; offset++)
+  {
+    if (offset == size)
+      return;                                 /* all keys are equal */
+    if (n <= MSD_RADIX_INSERTION_SORT)
+    {
+      msd_insertion_sort(base, n, offset, size);
+      return;
+    }
+    bzero((uchar*) end, sizeof end);
+    for (i= 0; i < n; i++)
+      end[base[i][offset]]++;
+    if (end[base[0][offset]] != n)
+      break;
+    /* All keys share this byte; look at the next one. */
+  }
+
+  /* Convert the counts to start positions, and distribute */
+  for (b= 0, start= 0; b < 256; b++)
+  {
+    uint32 c= end[b];
+    end[b]= start;
+    start+= c;
+  }
+  for (i= 0; i < n; i++)
+    buffer[end[base[i][offset]]++]= base[i];
+  memcpy(base, buffer, n * sizeof *base);
+
+  /* Now end[b] is the end position of each partition */
+  for (b= 0, start= 0; b < 256; b++)
+  {
+    if (end[b] - start > 1)
+      msd_radix_sort(base + start, end[b] - start, offset + 1, size,
+                     buffer + start);
+    start= end[b];
+  }
+}
+
+void radixsort_msd_for_str_ptr(uchar **base, uint number_of_elements,
+                               size_t size_of_element, uchar **buffer)
+{
+  if (number_of_elements > 1)
+    msd_radix_sort(base, number_of_elements, 0, size_of_element, buffer);
+}
@@ -250,6 +250,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
   uint sort_len= sortlength(thd, sort_keys, &allow_packing_for_sortkeys);
 
   param.init_for_filesort(sort_len, table, max_rows, filesort->sort_positions);
+  param.max_threads= (uint) thd->variables.max_sort_threads;
 
   sort->addon_fields=  param.addon_fields;
   sort->sort_keys= param.sort_keys;
@@ -425,6 +426,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
                     outfile))
       goto err;
   }
+  tracker->report_sort_threads(param.sort_threads);
 
   if (num_rows > param.max_rows)
   {
@@ -1039,7 +1041,7 @@ write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
   Merge_chunk buffpek;
   DBUG_ENTER("write_keys");
 
-  fs_info->sort_buffer(param, count);
+  set_if_bigger(param->sort_threads, fs_info->sort_buffer(param, count));
 
   if (!my_b_inited(tempfile) &&
       open_cached_file(tempfile, mysql_tmpdir, TEMP_PREFIX, DISK_BUFFER_SIZE,
@@ -1438,7 +1440,7 @@ static bool save_index(Sort_param *param, uint count,
   DBUG_ENTER("save_index");
   DBUG_ASSERT(table_sort->record_pointers == 0);
 
-  table_sort->sort_buffer(param, count);
+  set_if_bigger(param->sort_threads, table_sort->sort_buffer(param, count));
 
   if (param->using_addon_fields())
   {
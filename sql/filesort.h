@@ -146,9 +146,10 @@ class SORT_INFO
   ha_rows   examined_rows;	/* How many rows read */
   ha_rows   found_rows;         /* How many rows was accepted */
 
-  /** Sort filesort_buffer */
-  void sort_buffer(Sort_param *param, uint count)
-  { filesort_buffer.sort_buffer(param, count); }
+  /** Sort filesort_buffer
+  @return number of threads that were used for sorting */
+  uint sort_buffer(Sort_param *param, uint count)
+  { return filesort_buffer.sort_buffer(param, count); }
 
   uchar **get_sort_keys()
   { return filesort_buffer.get_sort_keys(); }
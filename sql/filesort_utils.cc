@@ -20,6 +20,14 @@
 #include "sql_sort.h"
 #include "table.h"
 
+#include "mysqld.h"                            // key_thread_sort
+#include "tpool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
 
 PSI_memory_key key_memory_Filesort_buffer_sort_keys;
 
@@ -159,30 +167,251 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
-void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+/** Worker threads for parallel sorting, see run_in_parallel() */
+static tpool::thread_pool *sort_thread_pool;
+
+static void sort_thread_init()
+{
+  my_thread_init();
+  PSI_CALL_set_thread(PSI_CALL_new_thread(key_thread_sort, NULL, 0));
+}
+
+static void sort_thread_end()
+{
+  PSI_CALL_delete_current_thread();
+  my_thread_end();
+}
+
+void filesort_thread_pool_init()
+{
+  DBUG_ASSERT(!sort_thread_pool);
+  sort_thread_pool= tpool::create_thread_pool_generic(1, MAX_SORT_THREADS);
+  sort_thread_pool->set_thread_callbacks(sort_thread_init, sort_thread_end);
+}
+
+void filesort_thread_pool_end()
+{
+  delete sort_thread_pool;
+  sort_thread_pool= NULL;
+}
+
+
+namespace {
+/** Minimum number of keys for each thread of a parallel sort */
+const uint PARALLEL_SORT_MIN_KEYS= 16384;
+
+/**
+  Invocations f(0), f(1), ..., f(n-1) that are shared between the
+  calling thread and n-1 tasks of sort_thread_pool. Each participant
+  claims the next unclaimed invocation, so that the calling thread does
+  not wait for tasks that the pool did not start yet: it runs their
+  share, and waits only for the tasks that are already running. Tasks
+  that the pool starts later find the run closed and do nothing; the
+  last reference, held by the calling thread or by a task, frees it.
+
+  Only fixed-size sort keys are compared in the tasks; that does not
+  access the THD or the tables, which remain owned by the connection.
+*/
+template<typename F> class Parallel_run
+{
+  /** A task of sort_thread_pool that releases its reference to the run */
+  class Task : public tpool::task
+  {
+  public:
+    Task(Parallel_run *run) : tpool::task(task_func, run) {}
+    void release() override
+    { static_cast<Parallel_run*>(get_arg())->release(); }
+  };
+
+  /** The invocations; only accessed while the run is not closed */
+  const F &m_f;
+  const uint m_n;
+  /** The next invocation to claim */
+  std::atomic<uint> m_next;
+  std::vector<Task> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_finished;
+  /** Number of tasks in work(); protected by m_mutex */
+  uint m_running;
+  /** Whether the calling thread is done; protected by m_mutex */
+  bool m_closed;
+  /** References by the calling thread and the submitted tasks;
+  protected by m_mutex */
+  uint m_refs;
+
+  Parallel_run(uint n, const F &f)
+    : m_f(f), m_n(n), m_next(0), m_running(0), m_closed(false), m_refs(1)
+  {
+    m_tasks.reserve(n - 1);
+    for (uint i= 1; i < n; i++)
+      m_tasks.emplace_back(this);
+  }
+
+  void work()
+  {
+    for (uint i; (i= m_next.fetch_add(1, std::memory_order_relaxed)) < m_n; )
+      m_f(i);
+  }
+
+  void release()
+  {
+    bool last;
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      last= !--m_refs;
+    }
+    if (last)
+      delete this;
+  }
+
+  static void task_func(void *arg)
+  {
+    Parallel_run *run= static_cast<Parallel_run*>(arg);
+    {
+      std::lock_guard<std::mutex> lk(run->m_mutex);
+      if (run->m_closed)
+        return;
+      run->m_running++;
+    }
+    run->work();
+    std::lock_guard<std::mutex> lk(run->m_mutex);
+    if (!--run->m_running && run->m_closed)
+      run->m_finished.notify_one();
+  }
+
+  void execute()
+  {
+    m_refs+= uint(m_tasks.size());
+    for (Task &t : m_tasks)
+      sort_thread_pool->submit_task(&t);
+    work();
+    {
+      std::unique_lock<std::mutex> lk(m_mutex);
+      m_closed= true;
+      while (m_running)
+        m_finished.wait(lk);
+    }
+    release();
+  }
+
+public:
+  static void run(uint n, const F &f)
+  {
+    Parallel_run *run;
+    try
+    {
+      run= new Parallel_run(n, f);
+    }
+    catch (...)
+    {
+      /* Run everything in the calling thread. */
+      for (uint i= 0; i < n; i++)
+        f(i);
+      return;
+    }
+    run->execute();
+  }
+};
+
+/**
+  Invoke f(0), f(1), ..., f(n-1) in parallel, using the calling thread
+  and up to n-1 threads of sort_thread_pool.
+*/
+template<typename F> void run_in_parallel(uint n, const F &f)
+{
+  Parallel_run<F>::run(n, f);
+}
+
+/**
+  Sort an array of pointers to fixed-size keys with several threads.
+  Each thread sorts a contiguous chunk of the array, and then the sorted
+  chunks are merged pairwise, with the merges of each round also
+  executed in parallel.
+
+  @param keys       the key pointers to sort
+  @param count      number of keys
+  @param n_threads  number of threads to use
+  @param cmp        comparison function
+  @param cmp_arg    argument of the comparison function
+  @param buffer     scratch space for count pointers
+*/
+void parallel_sort(uchar **keys, uint count, uint n_threads,
+                   qsort2_cmp cmp, void *cmp_arg, uchar **buffer)
+{
+  std::vector<uint> bounds(n_threads + 1);
+  for (uint i= 0; i <= n_threads; i++)
+    bounds[i]= uint(ulonglong(count) * i / n_threads);
+
+  run_in_parallel(n_threads, [&](uint i) {
+    my_qsort2(keys + bounds[i], bounds[i + 1] - bounds[i], sizeof(uchar*),
+              cmp, cmp_arg);
+  });
+
+  auto less= [cmp, cmp_arg](const uchar *a, const uchar *b)
+  { return cmp(cmp_arg, &a, &b) < 0; };
+  uchar **from= keys, **to= buffer;
+
+  while (bounds.size() > 2)
+  {
+    const uint n_runs= uint(bounds.size() - 1);
+    run_in_parallel((n_runs + 1) / 2, [&](uint i) {
+      uchar **first= from + bounds[2 * i];
+      uchar **mid= from + bounds[std::min(2 * i + 1, n_runs)];
+      uchar **last= from + bounds[std::min(2 * i + 2, n_runs)];
+      std::merge(first, mid, mid, last, to + bounds[2 * i], less);
+    });
+
+    std::vector<uint> merged;
+    for (uint i= 0; i < n_runs; i+= 2)
+      merged.push_back(bounds[i]);
+    merged.push_back(count);
+    bounds.swap(merged);
+    std::swap(from, to);
+  }
+
+  if (from != keys)
+    memcpy(keys, from, count * sizeof(uchar*));
+}
+}
+
+uint Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
   m_sort_keys= get_sort_keys();
 
   if (count <= 1 || size == 0)
-    return;
+    return 1;
 
   // don't reverse for PQ, it is already done
   if (!param->using_pq)
     reverse_record_pointers();
 
   uchar **buffer= NULL;
+  const uint n_threads= std::min(param->max_threads,
+                                 count / PARALLEL_SORT_MIN_KEYS);
+  if (n_threads > 1 && !param->using_packed_sortkeys() &&
+      (buffer= (uchar**) my_malloc(PSI_INSTRUMENT_ME, count*sizeof(char*),
+                                   MYF(MY_THREAD_SPECIFIC))))
+  {
+    parallel_sort(m_sort_keys, count, n_threads,
+                  param->get_compare_function(),
+                  param->get_compare_argument(&size), buffer);
+    my_free(buffer);
+    return n_threads;
+  }
+
   if (!param->using_packed_sortkeys() &&
-      radixsort_is_appliccable(count, param->sort_length) &&
+      radixsort_msd_is_appliccable(count, param->sort_length) &&
       (buffer= (uchar**) my_malloc(PSI_INSTRUMENT_ME, count*sizeof(char*),
                                    MYF(MY_THREAD_SPECIFIC))))
   {
-    radixsort_for_str_ptr(m_sort_keys, count, param->sort_length, buffer);
+    radixsort_msd_for_str_ptr(m_sort_keys, count, param->sort_length, buffer);
     my_free(buffer);
-    return;
+    return 1;
   }
 
   my_qsort2(m_sort_keys, count, sizeof(uchar*),
             param->get_compare_function(),
             param->get_compare_argument(&size));
+  return 1;
 }
@@ -81,8 +81,11 @@ class Filesort_buffer
     m_size_in_bytes(0), m_idx(0)
   {}
 
-  /** Sort me... */
-  void sort_buffer(const Sort_param *param, uint count);
+  /**
+    Sort me...
+    @return number of threads that were used for sorting
+  */
+  uint sort_buffer(const Sort_param *param, uint count);
 
   /**
     Reverses the record pointer array, to avoid recording new results for
@@ -283,4 +286,10 @@ int compare_packed_sort_keys(void *sort_keys, unsigned char **a,
                              unsigned char **b);
 qsort2_cmp get_packed_keys_compare_ptr();
 
+/** Maximum value of max_sort_threads */
+#define MAX_SORT_THREADS 64
+
+void filesort_thread_pool_init();
+void filesort_thread_pool_end();
+
 #endif  // FILESORT_UTILS_INCLUDED
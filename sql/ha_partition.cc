@@ -9726,6 +9726,31 @@ ha_rows ha_partition::records()
 }
 
 
+/*
+  Count the rows in all used partitions, see handler::count_rows()
+*/
+
+ha_rows ha_partition::count_rows()
+{
+  ha_rows tot_rows= 0;
+  uint i;
+  DBUG_ENTER("ha_partition::count_rows");
+
+  for (i= bitmap_get_first_set(&m_part_info->read_partitions);
+       i < m_tot_parts;
+       i= bitmap_get_next_set(&m_part_info->read_partitions, i))
+  {
+    const ha_rows rows= (m_file[i]->ha_table_flags() & HA_HAS_RECORDS)
+      ? m_file[i]->records() : m_file[i]->count_rows();
+    if (unlikely(rows == HA_POS_ERROR))
+      DBUG_RETURN(HA_POS_ERROR);
+    tot_rows+= rows;
+  }
+  DBUG_PRINT("exit", ("count_rows: %lld", (longlong) tot_rows));
+  DBUG_RETURN(tot_rows);
+}
+
+
 /*
   Is it ok to switch to a new engine for this table
 
@@ -1047,6 +1047,7 @@ class ha_partition :public handler
   */
   uint8 table_cache_type() override;
   ha_rows records() override;
+  ha_rows count_rows() override;
 
   /* Calculate hash value for PARTITION BY KEY tables. */
   static uint32 calculate_key_hash_value(Field **field_array);
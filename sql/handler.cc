@@ -6631,6 +6631,10 @@ int handler::binlog_log_row(TABLE *table,
 
   error= (*log_func)(thd, table, row_logging_has_trans,
                      before_record, after_record);
+  if (!error && opt_binlog_transaction_dependency_tracking ==
+                BINLOG_DEPENDENCY_TRACKING_WRITESET)
+    binlog_add_writeset(thd, table, before_record, after_record,
+                        row_logging_has_trans);
   DBUG_RETURN(error ? HA_ERR_RBR_LOGGING_FAILED : 0);
 }
 
@@ -353,7 +353,13 @@ enum chf_create_flags {
  */
 #define HA_ONLINE_ANALYZE             (1ULL << 59)
 
-#define HA_LAST_TABLE_FLAG HA_ONLINE_ANALYZE
+/*
+  count_rows() can count the rows of the table exactly. Unlike records(),
+  it may have to read the whole table.
+*/
+#define HA_CAN_COUNT_ROWS             (1ULL << 60)
+
+#define HA_LAST_TABLE_FLAG HA_CAN_COUNT_ROWS
 
 
 /* bits in index_flags(index_number) for what you can do with index */
@@ -3650,6 +3656,13 @@ class handler :public Sql_alloc
   */
   virtual int pre_records() { return 0; }
   virtual ha_rows records() { return stats.records; }
+  /**
+    Count the rows in the table for COUNT(*) without a WHERE condition.
+    It will only be called if (table_flags() & HA_CAN_COUNT_ROWS) != 0.
+    @return the number of rows, or HA_POS_ERROR if the rows should rather
+    be counted by reading them through the handler interface
+  */
+  virtual ha_rows count_rows() { return HA_POS_ERROR; }
   /**
     Return upper bound of current number of records in the table
     (max. of how many records one will retrieve when doing a full table scan)
@@ -4109,6 +4122,11 @@ class handler :public Sql_alloc
   get_parent_foreign_key_list(THD *thd, List<FOREIGN_KEY_INFO> *f_key_list)
   { return 0; }
   virtual uint referenced_by_foreign_key() { return 0;}
+  /**
+    Check if the table has foreign keys or is referenced by one, without
+    building the lists of them.
+  */
+  virtual bool has_foreign_keys() { return referenced_by_foreign_key(); }
   virtual void init_table_handle_for_HANDLER()
   { return; }       /* prepare InnoDB for HANDLER */
   virtual void free_foreign_key_create_info(char* str) {}
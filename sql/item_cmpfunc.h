@@ -898,6 +898,10 @@ class Item_func_opt_neg :public Item_bool_func
   {
     return cmp_collation.collation;
   }
+  const Type_handler *compare_type_handler() const
+  {
+    return m_comparator.type_handler();
+  }
   Item *propagate_equal_fields(THD *, const Context &,
                                COND_EQUAL *) override= 0;
 };
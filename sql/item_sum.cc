@@ -863,8 +863,9 @@ bool Aggregator_distinct::setup(THD *thd)
         }
       }
       DBUG_ASSERT(tree == 0);
+      /* Keys that compare bytewise can be kept in a hash table */
       tree= new Unique(compare_key, cmp_arg, tree_key_length,
-                       item_sum->ram_limitation(thd));
+                       item_sum->ram_limitation(thd), 0, all_binary);
       /*
         The only time tree_key_length could be 0 is if someone does
         count(distinct) on a char(0) field - stupid thing to do,
@@ -918,10 +919,11 @@ bool Aggregator_distinct::setup(THD *thd)
       Unique handles all unique elements in a tree until they can't fit
       in.  Then the tree is dumped to the temporary file. We can use
       simple_raw_key_cmp because the table contains numbers only; decimals
-      are converted to binary representation as well.
+      are converted to binary representation as well. For the same reason
+      the values can be kept in a hash table.
     */
     tree= new Unique(simple_raw_key_cmp, &tree_key_length, tree_key_length,
-                     item_sum->ram_limitation(thd));
+                     item_sum->ram_limitation(thd), 0, true);
 
     DBUG_RETURN(tree == 0);
   }
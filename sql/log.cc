@@ -29,6 +29,7 @@
 #include "sql_priv.h"
 #include "log.h"
 #include "sql_base.h"                           // open_log_table
+#include "key.h"                                // key_copy, key_hashnr
 #include "sql_repl.h"
 #include "sql_delete.h"                         // mysql_truncate
 #include "sql_parse.h"                          // command_name
@@ -109,6 +110,7 @@ ulong opt_binlog_dbug_fsync_sleep= 0;
 
 mysql_mutex_t LOCK_prepare_ordered;
 mysql_cond_t COND_prepare_ordered;
+mysql_mutex_t LOCK_binlog_sync;
 mysql_mutex_t LOCK_after_binlog_sync;
 mysql_mutex_t LOCK_commit_ordered;
 
@@ -528,7 +530,8 @@ class binlog_cache_mngr {
                     ulong *param_ptr_binlog_stmt_cache_disk_use,
                     ulong *param_ptr_binlog_cache_use,
                     ulong *param_ptr_binlog_cache_disk_use)
-    : last_commit_pos_offset(0), using_xa(FALSE), xa_xid(0)
+    : last_commit_pos_offset(0), using_xa(FALSE), xa_xid(0),
+      writeset(PSI_INSTRUMENT_MEM), writeset_unknown(false)
   {
      stmt_cache.set_binlog_cache_info(param_max_binlog_stmt_cache_size,
                                       param_ptr_binlog_stmt_cache_use,
@@ -549,6 +552,8 @@ class binlog_cache_mngr {
       using_xa= FALSE;
       last_commit_pos_file[0]= 0;
       last_commit_pos_offset= 0;
+      writeset.clear();
+      writeset_unknown= false;
     }
   }
 
@@ -590,6 +595,13 @@ class binlog_cache_mngr {
   ulong binlog_id;
   /* Set if we get an error during commit that must be returned from unlog(). */
   bool delayed_error;
+  /*
+    Hashes of the unique key values modified by the transaction cache, see
+    binlog_add_writeset(). writeset_unknown is set when the transaction
+    contains something that the hashes cannot describe.
+  */
+  Dynamic_array<ulonglong> writeset;
+  bool writeset_unknown;
 
 private:
 
@@ -3387,6 +3399,7 @@ MYSQL_BIN_LOG::MYSQL_BIN_LOG(uint *sync_period)
    group_commit_trigger_count(0), group_commit_trigger_timeout(0),
    group_commit_trigger_lock_wait(0),
    sync_period_ptr(sync_period), sync_counter(0),
+   binlog_flushed_offset(0), binlog_synced_offset(0),
    state_file_deleted(false), binlog_state_recover_done(false),
    is_relay_log(0), relay_signal_cnt(0),
    checksum_alg_reset(BINLOG_CHECKSUM_ALG_UNDEF),
@@ -3969,6 +3982,9 @@ bool MYSQL_BIN_LOG::open(const char *log_name,
       my_delete(buf, MY_SYNC_DIR);
       state_file_deleted= true;
     }
+
+    if (opt_binlog_gtid_index)
+      gtid_index.open(log_file_name, opt_binlog_gtid_index_span_min);
   }
 
   log_state= LOG_OPENED;
@@ -4310,11 +4326,12 @@ bool MYSQL_BIN_LOG::reset_logs(THD *thd, bool create_new_log,
       Without binlog, we cannot XA recover prepared-but-not-committed
       transactions in engines. So force a commit checkpoint first.
 
-      Note that we take and immediately
-      release LOCK_after_binlog_sync/LOCK_commit_ordered. This has
+      Note that we take and immediately release
+      LOCK_binlog_sync/LOCK_after_binlog_sync/LOCK_commit_ordered. This has
       the effect to ensure that any on-going group commit (in
       trx_group_commit_leader()) has completed before we request the checkpoint,
-      due to the chaining of LOCK_log and LOCK_commit_ordered in that function.
+      due to the chaining of LOCK_log, LOCK_binlog_sync,
+      LOCK_after_binlog_sync and LOCK_commit_ordered in that function.
       (We are holding LOCK_log, so no new group commit can start).
 
       Without this, it is possible (though perhaps unlikely) that the RESET
@@ -4323,7 +4340,9 @@ bool MYSQL_BIN_LOG::reset_logs(THD *thd, bool create_new_log,
       later would leave such transaction not recoverable.
     */
 
+    mysql_mutex_lock(&LOCK_binlog_sync);
     mysql_mutex_lock(&LOCK_after_binlog_sync);
+    mysql_mutex_unlock(&LOCK_binlog_sync);
     mysql_mutex_lock(&LOCK_commit_ordered);
     mysql_mutex_unlock(&LOCK_after_binlog_sync);
     mysql_mutex_unlock(&LOCK_commit_ordered);
@@ -4408,6 +4427,7 @@ bool MYSQL_BIN_LOG::reset_logs(THD *thd, bool create_new_log,
         goto err;
       }
     }
+    gtid_index_delete(linfo.log_file_name);
     if (find_next_log(&linfo, 0))
       break;
   }
@@ -4998,6 +5018,7 @@ int MYSQL_BIN_LOG::purge_index_entry(THD *thd, ulonglong *reclaimed_space,
         {
           if (reclaimed_space)
             *reclaimed_space+= s.st_size;
+          gtid_index_delete(log_info.log_file_name);
         }
         else
         {
@@ -5561,6 +5582,12 @@ bool MYSQL_BIN_LOG::flush_and_sync(bool *synced)
   if (synced)
     *synced= 0;
   mysql_mutex_assert_owner(&LOCK_log);
+  /*
+    Callers go on to report_binlog_update() and LOCK_after_binlog_sync,
+    which must stay in binlog order with a group commit still syncing.
+  */
+  if (!is_relay_log)
+    wait_for_binlog_sync();
   if (flush_io_cache(&log_file))
     return 1;
   uint sync_period= get_sync_period();
@@ -5668,6 +5695,105 @@ bool use_trans_cache(const THD* thd, bool is_transactional)
           !cache_mngr->trx_cache.empty());
 }
 
+
+/**
+  Add the unique key values of a logged row change to the writeset of the
+  current transaction, for binlog_transaction_dependency_tracking=WRITESET.
+
+  Only unique keys without NULL values identify a row. If a row has NULLs
+  in every unique key of the table (or the table has none), or the change
+  goes to the transaction cache but the table is not transactional, the
+  transaction is marked as having an unknown writeset and will never be
+  grouped with others.
+
+  The same is done for tables that have foreign keys or are referenced by
+  one. A child row depends on a parent row with different key values,
+  possibly in another table, and a slave that applied such transactions
+  out of order would stop with a foreign key error, which is not retried.
+
+  @param thd              The client thread.
+  @param table            The table that was changed.
+  @param before_record    Row before the change, or NULL for an insert.
+  @param after_record     Row after the change, or NULL for a delete.
+  @param is_transactional The changes are related to a trx-table.
+*/
+void binlog_add_writeset(THD *thd, TABLE *table, const uchar *before_record,
+                         const uchar *after_record, bool is_transactional)
+{
+  binlog_cache_mngr *const cache_mngr=
+    (binlog_cache_mngr*) thd_get_ha_data(thd, binlog_hton);
+  DBUG_ENTER("binlog_add_writeset");
+
+  if (!cache_mngr || cache_mngr->writeset_unknown)
+    DBUG_VOID_RETURN;
+  if (!is_transactional)
+  {
+    /*
+      Changes logged to the statement cache are binlogged as their own
+      event group, which never takes part in writeset grouping.
+    */
+    if (use_trans_cache(thd, is_transactional))
+      goto unknown;
+    DBUG_VOID_RETURN;
+  }
+
+  if (table->file->has_foreign_keys())
+    goto unknown;
+
+  {
+    const uchar *records[2]= { before_record, after_record };
+    uchar key_buff[MAX_KEY_LENGTH];
+    ulonglong table_hash= my_hash_sort(&my_charset_bin,
+                                       (uchar*) table->s->table_cache_key.str,
+                                       table->s->table_cache_key.length);
+    /* Whether the row before and after the change is identified */
+    bool hashed[2]= { !before_record, !after_record };
+
+    for (uint key_nr= 0; key_nr < table->s->keys; key_nr++)
+    {
+      KEY *key_info= table->key_info + key_nr;
+      if (!(key_info->flags & HA_NOSAME) ||
+          key_info->algorithm == HA_KEY_ALG_LONG_HASH)
+        continue;
+
+      for (uint i= 0; i < 2; i++)
+      {
+        const uchar *record= records[i];
+        if (!record)
+          continue;
+        KEY_PART_INFO *key_part= key_info->key_part;
+        KEY_PART_INFO *key_part_end= key_part +
+                                     key_info->user_defined_key_parts;
+        for (; key_part < key_part_end; key_part++)
+        {
+          if (key_part->field->is_null_in_record(record))
+            break;
+        }
+        if (key_part < key_part_end)
+          continue;                     // NULL values never conflict
+
+        key_copy(key_buff, record, key_info, key_info->key_length);
+        ulonglong hash= (table_hash << 32 | key_nr) ^
+          (ulonglong) key_hashnr(key_info, key_info->user_defined_key_parts,
+                                 key_buff) * 0x9E3779B97F4A7C15ULL;
+        if (cache_mngr->writeset.append(hash))
+          goto unknown;
+        hashed[i]= true;
+      }
+    }
+    if (!hashed[0] || !hashed[1] ||
+        cache_mngr->writeset.elements() >
+        opt_binlog_transaction_dependency_history_size)
+      goto unknown;
+  }
+  DBUG_VOID_RETURN;
+
+unknown:
+  cache_mngr->writeset.clear();
+  cache_mngr->writeset_unknown= true;
+  DBUG_VOID_RETURN;
+}
+
 /**
   This function checks if a transaction, either a multi-statement
   or a single statement transaction is about to commit or not.
@@ -6291,9 +6417,11 @@ MYSQL_BIN_LOG::write_gtid_event(THD *thd, bool standalone,
   }
 #endif
 
+  gtid_index.event_group_start(my_b_tell(&log_file));
   if (write_event(&gtid_event))
     DBUG_RETURN(true);
   status_var_add(thd->status_var.binlog_bytes_written, gtid_event.data_written);
+  gtid_index.gtid_written(&gtid);
 
   DBUG_RETURN(false);
 }
@@ -6607,6 +6735,7 @@ bool MYSQL_BIN_LOG::write(Log_event *event_info, my_bool *with_annotate)
       my_org_b_tell= my_b_tell(file);
       mysql_mutex_lock(&LOCK_log);
       prev_binlog_id= current_binlog_id;
+      writeset_history.clear();
       DBUG_EXECUTE_IF("binlog_force_commit_id",
         {
           const LEX_CSTRING commit_name= { STRING_WITH_LEN("commit_id") };
@@ -6633,6 +6762,9 @@ bool MYSQL_BIN_LOG::write(Log_event *event_info, my_bool *with_annotate)
       is_trans_cache= use_trans_cache(thd, using_trans);
       cache_data= cache_mngr->get_binlog_cache_data(is_trans_cache);
       file= &cache_data->cache_log;
+      /* Statement events carry no writeset */
+      if (is_trans_cache)
+        cache_mngr->writeset_unknown= true;
 
       if (thd->lex->stmt_accessed_non_trans_temp_table())
         cache_data->set_changes_to_non_trans_temp_table();
@@ -8160,6 +8292,180 @@ MYSQL_BIN_LOG::write_transaction_to_binlog_events(group_commit_entry *entry)
   return 1;
 }
 
+/*
+  Resize the hash table to hold history_size hashes at a load factor of at
+  most 1/2. Returns false if out of memory.
+*/
+bool Binlog_writeset_history::resize(size_t history_size)
+{
+  size_t size= my_round_up_to_next_power((uint32) history_size * 2);
+  if (size == m_size)
+    return true;
+
+  Entry *entries= (Entry*) my_malloc(PSI_INSTRUMENT_ME, size * sizeof(Entry),
+                                     MYF(MY_ZEROFILL));
+  if (!entries)
+    return false;
+  my_free(m_entries);
+  m_entries= entries;
+  m_size= size;
+  m_generation= 1;
+  m_count= 0;
+  m_commit_id= 0;
+  return true;
+}
+
+
+bool Binlog_writeset_history::find(ulonglong hash) const
+{
+  for (size_t i= hash & (m_size - 1); ; i= (i + 1) & (m_size - 1))
+  {
+    if (m_entries[i].generation != m_generation)
+      return false;
+    if (m_entries[i].hash == hash)
+      return true;
+  }
+}
+
+
+void Binlog_writeset_history::insert(ulonglong hash)
+{
+  for (size_t i= hash & (m_size - 1); ; i= (i + 1) & (m_size - 1))
+  {
+    if (m_entries[i].generation != m_generation)
+    {
+      m_entries[i].hash= hash;
+      m_entries[i].generation= m_generation;
+      m_count++;
+      return;
+    }
+    if (m_entries[i].hash == hash)
+      return;
+  }
+}
+
+
+/*
+  Decide the commit_id of the next transaction written to the binlog.
+
+  @param hashes             Writeset of the transaction, or NULL if unknown.
+  @param count              Number of hashes.
+  @param default_commit_id  The commit_id of the binlog group commit, used
+                            for transactions with an unknown writeset.
+
+  @return commit_id to write in the GTID event of the transaction.
+*/
+uint64
+Binlog_writeset_history::get_commit_id(const ulonglong *hashes, size_t count,
+                                       uint64 default_commit_id)
+{
+  size_t history_size= opt_binlog_transaction_dependency_history_size;
+  if (!hashes || !count || count > history_size || !resize(history_size))
+  {
+    clear();
+    return default_commit_id;
+  }
+
+  bool conflict= !m_commit_id || m_count + count > history_size;
+  for (size_t i= 0; !conflict && i < count; i++)
+    conflict= find(hashes[i]);
+  if (conflict)
+  {
+    clear();
+    m_commit_id= ++m_last_commit_id;
+  }
+  for (size_t i= 0; i < count; i++)
+    insert(hashes[i]);
+  return m_commit_id;
+}
+
+
+void MYSQL_BIN_LOG::set_group_commit_write_error(group_commit_entry *queue)
+{
+  for (group_commit_entry *current= queue; current; current= current->next)
+  {
+    if (!current->error)
+    {
+      current->error= ER_ERROR_ON_WRITE;
+      current->commit_errno= errno;
+      current->error_cache= NULL;
+    }
+  }
+}
+
+
+/*
+  Wait for the sync stage of a group commit that has already released
+  LOCK_log, see trx_group_commit_leader().
+
+  Called with LOCK_log held before anything that must be ordered after such
+  a group (publishing binlog_end_pos, semi-sync report_binlog_update()).
+  No new sync stage can start until LOCK_log is released.
+*/
+void MYSQL_BIN_LOG::wait_for_binlog_sync()
+{
+  mysql_mutex_lock(&LOCK_binlog_sync);
+  mysql_mutex_unlock(&LOCK_binlog_sync);
+}
+
+
+/*
+  Make the binlog durable up to at least offset.
+
+  Groups that were written while an earlier group was waiting for its fsync
+  are covered by that fsync, so they need not do one of their own.
+*/
+bool MYSQL_BIN_LOG::sync_binlog_file(my_off_t offset)
+{
+  mysql_mutex_assert_owner(&LOCK_binlog_sync);
+  if (binlog_synced_offset >= offset)
+    return false;
+  my_off_t flushed= binlog_flushed_offset.load(std::memory_order_acquire);
+  if (mysql_file_sync(log_file.file, MYF(MY_WME|MY_SYNC_FILESIZE)))
+    return true;
+#ifndef DBUG_OFF
+  if (opt_binlog_dbug_fsync_sleep > 0)
+    my_sleep(opt_binlog_dbug_fsync_sleep);
+#endif
+  binlog_synced_offset= flushed;
+  return false;
+}
+
+
+/*
+  Run the semi-sync after_flush hook for a group commit, in binlog order.
+  The caller then publishes the new binlog_end_pos, which must come after
+  the hook or the dump thread might send a transaction before semi-sync
+  has put it into its list.
+*/
+void MYSQL_BIN_LOG::report_group_commit_flushed(group_commit_entry *queue)
+{
+#ifdef HAVE_REPLICATION
+  bool any_error= false;
+
+  for (group_commit_entry *current= queue; current; current= current->next)
+  {
+    if (likely(!current->error) &&
+        unlikely(repl_semisync_master.
+                 report_binlog_update(current->thd,
+                                      current->cache_mngr->
+                                      last_commit_pos_file,
+                                      current->cache_mngr->
+                                      last_commit_pos_offset)))
+    {
+      current->error= ER_ERROR_ON_WRITE;
+      current->commit_errno= -1;
+      current->error_cache= NULL;
+      any_error= true;
+    }
+  }
+
+  if (unlikely(any_error))
+    sql_print_error("Failed to run 'after_flush' hooks");
+#endif
+}
+
+
 /*
   Do binlog group commit as the lead thread.
 
@@ -8178,6 +8484,7 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
   group_commit_entry *current, *last_in_queue;
   group_commit_entry *queue= NULL;
   bool check_purge= false;
+  bool sync_after_unlock= false;
   ulong UNINIT_VAR(binlog_id);
   uint64 commit_id;
   DBUG_ENTER("MYSQL_BIN_LOG::trx_group_commit_leader");
@@ -8263,8 +8570,23 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
                   !cache_mngr->trx_cache.empty()  ||
                   current->thd->transaction->xid_state.is_explicit_XA());
 
+      uint64 entry_commit_id= commit_id;
+      if (opt_binlog_transaction_dependency_tracking ==
+          BINLOG_DEPENDENCY_TRACKING_WRITESET)
+      {
+        bool known= current->using_trx_cache &&
+                    cache_mngr->stmt_cache.empty() &&
+                    !cache_mngr->writeset_unknown &&
+                    !current->thd->transaction->xid_state.is_explicit_XA();
+        entry_commit_id=
+          writeset_history.get_commit_id(known ?
+                                         cache_mngr->writeset.front() : NULL,
+                                         cache_mngr->writeset.elements(),
+                                         commit_id);
+      }
+
       if (unlikely((current->error= write_transaction_or_stmt(current,
-                                                              commit_id))))
+                                                              entry_commit_id))))
         current->commit_errno= errno;
 
       strmake_buf(cache_mngr->last_commit_pos_file, log_file_name);
@@ -8292,57 +8614,50 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
     }
     set_current_thd(leader->thd);
 
-    bool synced= 0;
-    if (unlikely(flush_and_sync(&synced)))
+    /*
+      With sync_binlog, the fsync is normally done in a separate sync stage
+      after LOCK_log has been released (see below), so that the next group
+      can write to the binlog while this one waits for the disk. A group
+      that is going to rotate the binlog syncs here instead, as rotate()
+      closes the file.
+    */
+    bool need_sync= false;
+    bool write_error= flush_io_cache(&log_file);
+    if (likely(!write_error))
     {
-      for (current= queue; current != NULL; current= current->next)
+      uint sync_period= get_sync_period();
+      binlog_flushed_offset.store(my_b_tell(&log_file),
+                                  std::memory_order_release);
+      if (sync_period && ++sync_counter >= sync_period)
       {
-        if (!current->error)
-        {
-          current->error= ER_ERROR_ON_WRITE;
-          current->commit_errno= errno;
-          current->error_cache= NULL;
-        }
+        sync_counter= 0;
+        need_sync= true;
+        sync_after_unlock= my_b_tell(&log_file) < (my_off_t) max_size;
       }
     }
-    else
+    if (!sync_after_unlock)
     {
-      bool any_error= false;
+      /*
+        Taking LOCK_binlog_sync also waits for the sync stage of the
+        previous group, keeping report_binlog_update() in binlog order.
+      */
+      mysql_mutex_lock(&LOCK_binlog_sync);
+      if (need_sync && !write_error)
+        write_error= sync_binlog_file(commit_offset);
+      mysql_mutex_unlock(&LOCK_binlog_sync);
+    }
 
+    if (unlikely(write_error))
+      set_group_commit_write_error(queue);
+    else if (!sync_after_unlock)
+    {
       mysql_mutex_assert_not_owner(&LOCK_prepare_ordered);
       mysql_mutex_assert_owner(&LOCK_log);
       mysql_mutex_assert_not_owner(&LOCK_after_binlog_sync);
       mysql_mutex_assert_not_owner(&LOCK_commit_ordered);
 
-      for (current= queue; current != NULL; current= current->next)
-      {
-#ifdef HAVE_REPLICATION
-        if (likely(!current->error) &&
-            unlikely(repl_semisync_master.
-                     report_binlog_update(current->thd,
-                                          current->cache_mngr->
-                                          last_commit_pos_file,
-                                          current->cache_mngr->
-                                          last_commit_pos_offset)))
-        {
-          current->error= ER_ERROR_ON_WRITE;
-          current->commit_errno= -1;
-          current->error_cache= NULL;
-          any_error= true;
-        }
-#endif
-      }
-
-      /*
-        update binlog_end_pos so it can be read by dump thread
-        Note: must be _after_ the RUN_HOOK(after_flush) or else
-        semi-sync might not have put the transaction into
-        it's list before dump-thread tries to send it
-      */
+      report_group_commit_flushed(queue);
       update_binlog_end_pos(commit_offset);
-
-      if (unlikely(any_error))
-        sql_print_error("Failed to run 'after_flush' hooks");
     }
 
     /*
@@ -8379,17 +8694,47 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
     commit_offset= my_b_write_tell(&log_file);
   }
 
-  DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
-  mysql_mutex_lock(&LOCK_after_binlog_sync);
-  /*
-    We cannot unlock LOCK_log until we have locked LOCK_after_binlog_sync;
-    otherwise scheduling could allow the next group commit to run ahead of us,
-    messing up the order of commit_ordered() calls. But as soon as
-    LOCK_after_binlog_sync is obtained, we can let the next group commit start.
-  */
-  mysql_mutex_unlock(&LOCK_log);
+  if (sync_after_unlock)
+  {
+    /*
+      The sync stage. LOCK_log is handed over to LOCK_binlog_sync, so the
+      next group commit can start writing while we fsync, and
+      LOCK_binlog_sync is in turn handed over to LOCK_after_binlog_sync,
+      so that groups still reach commit_ordered() in binlog order.
+    */
+    DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_binlog_sync");
+    mysql_mutex_lock(&LOCK_binlog_sync);
+    mysql_mutex_unlock(&LOCK_log);
+
+    DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
 
-  DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
+    if (unlikely(sync_binlog_file(commit_offset)))
+      set_group_commit_write_error(queue);
+    else
+    {
+      report_group_commit_flushed(queue);
+      update_binlog_end_pos_after_sync(commit_offset);
+    }
+
+    DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
+    mysql_mutex_lock(&LOCK_after_binlog_sync);
+    mysql_mutex_unlock(&LOCK_binlog_sync);
+  }
+  else
+  {
+    DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
+    mysql_mutex_lock(&LOCK_after_binlog_sync);
+    /*
+      We cannot unlock LOCK_log until we have locked LOCK_after_binlog_sync;
+      otherwise scheduling could allow the next group commit to run ahead of
+      us, messing up the order of commit_ordered() calls. But as soon as
+      LOCK_after_binlog_sync is obtained, we can let the next group commit
+      start.
+    */
+    mysql_mutex_unlock(&LOCK_log);
+
+    DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
+  }
 
   /*
     Loop through threads and run the binlog_sync hook
@@ -8795,6 +9140,16 @@ void MYSQL_BIN_LOG::close(uint exiting)
 
   mysql_mutex_assert_owner(&LOCK_log);
 
+  if (!is_relay_log)
+  {
+    /* A group commit may still be syncing this file without LOCK_log. */
+    mysql_mutex_lock(&LOCK_binlog_sync);
+    binlog_flushed_offset.store(0, std::memory_order_relaxed);
+    binlog_synced_offset= 0;
+    mysql_mutex_unlock(&LOCK_binlog_sync);
+    gtid_index.close();
+  }
+
   if (log_state == LOG_OPENED)
   {
     DBUG_ASSERT(log_type == LOG_BIN);
@@ -20,6 +20,8 @@
 #include "handler.h"                            /* my_xid */
 #include "wsrep_mysqld.h"
 #include "rpl_constants.h"
+#include "rpl_gtid_index.h"
+#include <atomic>
 
 class Relay_log_info;
 
@@ -34,6 +36,15 @@ bool ending_trans(THD* thd, const bool all);
 bool ending_single_stmt_trans(THD* thd, const bool all);
 bool trans_has_updated_non_trans_table(const THD* thd);
 bool stmt_has_updated_non_trans_table(const THD* thd);
+void binlog_add_writeset(THD *thd, TABLE *table, const uchar *before_record,
+                         const uchar *after_record, bool is_transactional);
+
+/* Values of @@binlog_transaction_dependency_tracking */
+enum enum_binlog_dependency_tracking
+{
+  BINLOG_DEPENDENCY_TRACKING_COMMIT_ORDER,
+  BINLOG_DEPENDENCY_TRACKING_WRITESET
+};
 
 /*
   Transaction Coordinator log - a base abstract class
@@ -90,11 +101,12 @@ class TC_LOG
 */
 extern mysql_mutex_t LOCK_prepare_ordered;
 extern mysql_cond_t COND_prepare_ordered;
+extern mysql_mutex_t LOCK_binlog_sync;
 extern mysql_mutex_t LOCK_after_binlog_sync;
 extern mysql_mutex_t LOCK_commit_ordered;
 #ifdef HAVE_PSI_INTERFACE
 extern PSI_mutex_key key_LOCK_prepare_ordered, key_LOCK_commit_ordered;
-extern PSI_mutex_key key_LOCK_after_binlog_sync;
+extern PSI_mutex_key key_LOCK_binlog_sync, key_LOCK_after_binlog_sync;
 extern PSI_cond_key key_COND_prepare_ordered;
 #endif
 
@@ -425,6 +437,62 @@ class binlog_cache_data;
 struct rpl_gtid;
 struct wait_for_commit;
 
+/*
+  Hashes of the unique key values modified by the transactions binlogged
+  so far in the current group of mutually independent transactions, used
+  with binlog_transaction_dependency_tracking=WRITESET.
+
+  All transactions of a group are written with the same commit_id, so a
+  slave in conservative parallel mode applies them in parallel. A
+  transaction whose writeset intersects the group, or whose writeset is
+  not known, starts a new group.
+
+  The hashes live in an open addressing table of entries tagged with a
+  generation number, so that starting a new group is just a generation
+  bump. Protected by LOCK_log.
+
+  Each group gets its commit_id from a counter of its own. Binlog group
+  commits use the query_id of their leader as commit_id, which is shared
+  by all commits of one statement (eg. a stored procedure loop), so the
+  counter lives in the upper half of the range that query ids never
+  reach. A slave merges consecutive equal commit_ids, so a new group must
+  never reuse the id of the one before it.
+*/
+class Binlog_writeset_history
+{
+public:
+  Binlog_writeset_history()
+    :m_entries(NULL), m_size(0), m_count(0), m_generation(1), m_commit_id(0),
+     m_last_commit_id(1ULL << 63)
+  {}
+  ~Binlog_writeset_history() { my_free(m_entries); }
+  uint64 get_commit_id(const ulonglong *hashes, size_t count,
+                       uint64 default_commit_id);
+  void clear()
+  {
+    m_generation++;
+    m_count= 0;
+    m_commit_id= 0;
+  }
+private:
+  struct Entry
+  {
+    ulonglong hash;
+    ulonglong generation;
+  };
+  bool resize(size_t history_size);
+  bool find(ulonglong hash) const;
+  void insert(ulonglong hash);
+
+  Entry *m_entries;
+  size_t m_size;
+  size_t m_count;
+  ulonglong m_generation;
+  uint64 m_commit_id;
+  /* commit_id of the last group started */
+  uint64 m_last_commit_id;
+};
+
 class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
 {
   /** The instrumentation key to use for @ LOCK_index. */
@@ -541,6 +609,8 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   /* The reason why the group commit was grouped */
   ulonglong group_commit_trigger_count, group_commit_trigger_timeout;
   ulonglong group_commit_trigger_lock_wait;
+  /* Dependency tracking for binlog_transaction_dependency_tracking */
+  Binlog_writeset_history writeset_history;
 
   /* binlog encryption data */
   struct Binlog_crypt_data crypto;
@@ -551,6 +621,16 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   */
   uint *sync_period_ptr;
   uint sync_counter;
+  /*
+    Sync stage of group commit, see trx_group_commit_leader().
+    binlog_flushed_offset is how far group commit has written the current
+    binlog file; binlog_synced_offset how much of that is known to be on
+    disk (protected by LOCK_binlog_sync).
+  */
+  std::atomic<my_off_t> binlog_flushed_offset;
+  my_off_t binlog_synced_offset;
+  /* GTID index of the current binlog file, protected by LOCK_log */
+  Gtid_index_writer gtid_index;
   bool state_file_deleted;
   bool binlog_state_recover_done;
 
@@ -573,6 +653,9 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   int queue_for_group_commit(group_commit_entry *entry);
   bool write_transaction_to_binlog_events(group_commit_entry *entry);
   void trx_group_commit_leader(group_commit_entry *leader);
+  bool sync_binlog_file(my_off_t offset);
+  void report_group_commit_flushed(group_commit_entry *queue);
+  static void set_group_commit_write_error(group_commit_entry *queue);
   bool is_xidlist_idle_nolock();
 public:
   /*
@@ -766,6 +849,7 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
       signal_relay_log_update();
     else
     {
+      wait_for_binlog_sync();
       lock_binlog_end_pos();
       binlog_end_pos= my_b_safe_tell(&log_file);
       signal_bin_log_update();
@@ -776,6 +860,7 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   {
     mysql_mutex_assert_owner(&LOCK_log);
     mysql_mutex_assert_not_owner(&LOCK_binlog_end_pos);
+    wait_for_binlog_sync();
     lock_binlog_end_pos();
     /*
       Note: it would make more sense to assert(pos > binlog_end_pos)
@@ -787,6 +872,23 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
     signal_bin_log_update();
     unlock_binlog_end_pos();
   }
+  /*
+    update_binlog_end_pos() for the sync stage of group commit, which runs
+    without LOCK_log. Later groups may already have moved the end position.
+  */
+  void update_binlog_end_pos_after_sync(my_off_t pos)
+  {
+    mysql_mutex_assert_owner(&LOCK_binlog_sync);
+    mysql_mutex_assert_not_owner(&LOCK_binlog_end_pos);
+    lock_binlog_end_pos();
+    if (pos > binlog_end_pos)
+    {
+      binlog_end_pos= pos;
+      signal_bin_log_update();
+    }
+    unlock_binlog_end_pos();
+  }
+  void wait_for_binlog_sync();
 
   void wait_for_sufficient_commits();
   void binlog_trigger_immediate_group_commit();
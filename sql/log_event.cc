@@ -3178,7 +3178,7 @@ Rows_log_event::Rows_log_event(const char *buf, uint event_len,
     m_extra_row_data(0)
 #if !defined(MYSQL_CLIENT) && defined(HAVE_REPLICATION)
     , m_curr_row(NULL), m_curr_row_end(NULL),
-    m_key(NULL), m_key_info(NULL), m_key_nr(0),
+    m_key(NULL), m_key_info(NULL), m_key_nr(0), m_hash_scan(NULL),
     master_had_triggers(0)
 #endif
 {
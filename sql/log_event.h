@@ -5171,10 +5171,17 @@ class Rows_log_event : public Log_event
   uchar    *m_key;      /* Buffer to keep key value during searches */
   KEY      *m_key_info; /* Pointer to KEY info for m_key_nr */
   uint      m_key_nr;   /* Key number */
+  /* Rows of the event located by a single table scan, see HASH_SCAN */
+  class Rows_hash_scan *m_hash_scan;
   bool master_had_triggers;     /* set after tables opening */
 
   int find_key(); // Find a best key to use in find_row()
   int find_row(rpl_group_info *);
+  int unpack_before_image(rpl_group_info *);
+  int init_hash_scan(rpl_group_info *);
+  int find_row_by_hash_scan(rpl_group_info *);
+  void free_hash_scan();
+  void prefetch_rows(rpl_group_info *);
   int write_row(rpl_group_info *, const bool);
   int update_sequence();
 
@@ -43,6 +43,7 @@
 #include "rpl_mi.h"
 #include "rpl_filter.h"
 #include "rpl_record.h"
+#include "rpl_row_prefetch.h"
 #include "transaction.h"
 #include <my_dir.h>
 #include "sql_show.h"    // append_identifier
@@ -5154,7 +5155,7 @@ Rows_log_event::Rows_log_event(THD *thd_arg, TABLE *tbl_arg, ulong tid,
     m_type(event_type), m_extra_row_data(0)
 #ifdef HAVE_REPLICATION
     , m_curr_row(NULL), m_curr_row_end(NULL),
-    m_key(NULL), m_key_info(NULL), m_key_nr(0),
+    m_key(NULL), m_key_info(NULL), m_key_nr(0), m_hash_scan(NULL),
     master_had_triggers(0)
 #endif
 {
@@ -5662,6 +5663,11 @@ int Rows_log_event::do_apply_event(rpl_group_info *rgi)
     if (!is_auto_inc_in_extra_columns())
       thd->variables.sql_mode= MODE_NO_AUTO_VALUE_ON_ZERO;
 
+    if (likely(!error) && global_rpl_row_prefetch_pool.enabled() &&
+        (get_general_type_code() == DELETE_ROWS_EVENT ||
+         get_general_type_code() == UPDATE_ROWS_EVENT))
+      prefetch_rows(rgi);
+
     // row processing loop
 
     /* 
@@ -7637,6 +7643,13 @@ int Rows_log_event::find_key()
       best_key= key;
       break;
     }
+    /*
+      Scanning a non-unique index for every row can be disabled in favour
+      of HASH_SCAN.
+    */
+    if (!(slave_rows_search_algorithms_options &
+          (1ULL << SLAVE_ROWS_INDEX_SCAN)))
+      continue;
     /*
       We can only use a non-unique key if it allows range scans (ie. skip
       FULLTEXT indexes and such).
@@ -7731,45 +7744,314 @@ static int row_not_found_error(rpl_group_info *rgi)
 }
 
 /**
-  Locate the current row in event's table.
+  Rows of an UPDATE or DELETE event on a table without a usable index,
+  matched against the table in a single scan (slave_rows_search_algorithms
+  HASH_SCAN).
+
+  Each before image is hashed on its column values. The table is then
+  scanned once and every row whose hash and contents match a before image
+  that is not matched yet has its position saved for that image. find_row()
+  fetches rows by these positions, so applying the event costs one table
+  scan instead of one scan per row.
+*/
+class Rows_hash_scan
+{
+public:
+  struct Row
+  {
+    const uchar *row;                           // Before image in the event
+    bool found;
+  };
+  struct Key
+  {
+    ulonglong hash;
+    size_t row_idx;
+  };
 
-  The current row is pointed by @c m_curr_row. Member @c m_width tells
-  how many columns are there in the row (this can be differnet from
-  the number of columns in the table). It is assumed that event's
-  table is already open and pointed by @c m_table.
+  Rows_hash_scan()
+    :rows(PSI_INSTRUMENT_MEM), keys(PSI_INSTRUMENT_MEM), refs(NULL),
+     ref_length(0), next_row(0), usable(false)
+  {}
+  ~Rows_hash_scan() { my_free(refs); }
 
-  If a corresponding record is found in the table it is stored in 
-  @c m_table->record[0]. Note that when record is located based on a primary 
-  key, it is possible that the record found differs from the row being located.
+  bool is_usable() const { return usable; }
 
-  If no key is specified or table does not have keys, a table scan is used to 
-  find the row. In that case the row should be complete and contain values for
-  all columns. However, it can still be shorter than the table, i.e. the table 
-  can contain extra columns not present in the row. It is also possible that 
-  the table has fewer columns than the row being located. 
+  static int cmp_keys(const Key *a, const Key *b)
+  {
+    return a->hash < b->hash ? -1 : a->hash > b->hash ? 1 :
+           (a->row_idx < b->row_idx ? -1 : a->row_idx > b->row_idx);
+  }
 
-  @returns Error code on failure, 0 on success. 
-  
-  @post In case of success @c m_table->record[0] contains the record found. 
-  Also, the internal "cursor" of the table is positioned at the record found.
+  /* Index of the first key with the given hash, or keys.elements() */
+  size_t lower_bound(ulonglong hash) const
+  {
+    size_t lo= 0, hi= keys.elements();
+    while (lo < hi)
+    {
+      size_t mid= (lo + hi) / 2;
+      if (keys.at(mid).hash < hash)
+        lo= mid + 1;
+      else
+        hi= mid;
+    }
+    return lo;
+  }
 
-  @note If the engine allows random access of the records, a combination of
-  @c position() and @c rnd_pos() will be used. 
+  Dynamic_array<Row> rows;                      // In event order
+  Dynamic_array<Key> keys;                      // Sorted by hash
+  uchar *refs;                                  // Positions of found rows
+  uint ref_length;
+  size_t next_row;                              // Next row to fetch
+  bool usable;
+};
 
-  Note that one MUST call ha_index_or_rnd_end() after this function if
-  it returns 0 as we must leave the row position in the handler intact
-  for any following update/delete command.
-*/
 
-int Rows_log_event::find_row(rpl_group_info *rgi)
+/*
+  Hash the columns of table->record[0] that record_compare() compares.
+  Blobs are left out as Field::hash() does not look at their contents;
+  equal records still get equal hashes.
+*/
+static ulonglong hash_scan_record(TABLE *table)
 {
-  DBUG_ENTER("Rows_log_event::find_row");
+  ulong nr1= 1, nr2= 4;
+  for (Field **ptr= table->field; *ptr; ptr++)
+  {
+    Field *field= *ptr;
+    if ((field->flags & BLOB_FLAG) ||
+        (table->versioned() && field->vers_sys_field()))
+      continue;
+    field->hash(&nr1, &nr2);
+  }
+  return nr1;
+}
 
-  DBUG_ASSERT(m_table && m_table->in_use != NULL);
 
+/**
+  Set up @c m_hash_scan for the rows of the event starting at the current
+  row, see Rows_hash_scan.
+
+  If the rows cannot be unpacked or memory is short, the hash scan is
+  marked as not usable and find_row() falls back to a table scan.
+
+  @returns Error code if the table could not be scanned, 0 otherwise.
+
+  @post @c m_table->record[0] and @c m_table->record[1] hold the before
+  image of the current row, as find_row() expects.
+*/
+int Rows_log_event::init_hash_scan(rpl_group_info *rgi)
+{
   TABLE *table= m_table;
+  const uchar *curr_row= m_curr_row;
+  const bool is_update= get_general_type_code() == UPDATE_ROWS_EVENT;
   int error= 0;
-  bool is_table_scan= false, is_index_scan= false;
+  size_t found= 0;
+  DBUG_ENTER("Rows_log_event::init_hash_scan");
+
+  if (!(m_hash_scan= new Rows_hash_scan()))
+    DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+  Rows_hash_scan *scan= m_hash_scan;
+
+  /* Hash the before image of every remaining row of the event */
+  while (m_curr_row < m_rows_end)
+  {
+    Rows_hash_scan::Row row= { m_curr_row, false };
+    Rows_hash_scan::Key key;
+    if (unpack_before_image(rgi))
+      goto not_usable;
+    key.hash= hash_scan_record(table);
+    key.row_idx= scan->rows.elements();
+    if (scan->rows.append(row) || scan->keys.append(key))
+      goto not_usable;
+    m_curr_row= m_curr_row_end;
+    if (is_update)
+    {
+      if (unpack_current_row(rgi, &m_cols_ai))
+        goto not_usable;
+      m_curr_row= m_curr_row_end;
+    }
+  }
+  scan->keys.sort(Rows_hash_scan::cmp_keys);
+  scan->ref_length= table->file->ref_length;
+  if (!(scan->refs= (uchar*) my_malloc(PSI_INSTRUMENT_ME,
+                                       scan->rows.elements() *
+                                       scan->ref_length, MYF(0))))
+    goto not_usable;
+
+  /* Match the table rows against the before images in a single scan */
+  if (unlikely((error= table->file->ha_rnd_init_with_error(1))))
+    goto end;
+  while (found < scan->rows.elements() &&
+         !(error= table->file->ha_rnd_next(table->record[0])))
+  {
+    ulonglong hash= hash_scan_record(table);
+    store_record(table, record[1]);
+    for (size_t i= scan->lower_bound(hash);
+         i < scan->keys.elements() && scan->keys.at(i).hash == hash; i++)
+    {
+      Rows_hash_scan::Row *row= &scan->rows.at(scan->keys.at(i).row_idx);
+      if (row->found)
+        continue;
+      m_curr_row= row->row;
+      unpack_before_image(rgi);
+      bool differ= record_compare(table);
+      restore_record(table, record[1]);
+      if (!differ)
+      {
+        table->file->position(table->record[0]);
+        memcpy(scan->refs + scan->keys.at(i).row_idx * scan->ref_length,
+               table->file->ref, scan->ref_length);
+        row->found= true;
+        found++;
+        break;
+      }
+    }
+  }
+  table->file->ha_rnd_end();
+  if (error == HA_ERR_END_OF_FILE)
+    error= 0;
+  if (unlikely(error))
+  {
+    table->file->print_error(error, MYF(0));
+    goto end;
+  }
+  scan->usable= true;
+  goto end;
+
+not_usable:
+  scan->rows.free_memory();
+  scan->keys.free_memory();
+
+end:
+  m_curr_row= curr_row;
+  unpack_before_image(rgi);
+  table->use_all_columns();
+  store_record(table, record[1]);
+  DBUG_RETURN(error);
+}
+
+
+/**
+  Hand the primary keys of the rows of the event to the row prefetch
+  threads, see rpl_row_prefetch.h.
+
+  This is only possible when the before image has all the primary key
+  columns, and only done for engines with row-level locking (all the
+  transactional ones). On other engines the read of a helper would wait for
+  the table lock held by this worker until the end of the statement,
+  stalling the other requests queued for that helper.
+
+  The rows are unpacked once more when they are applied, which is cheap
+  compared to the page reads that the prefetch saves.
+*/
+void Rows_log_event::prefetch_rows(rpl_group_info *rgi)
+{
+  TABLE *table= m_table;
+  uint keynr= table->s->primary_key;
+  const uchar *curr_row= m_curr_row;
+  const uchar *curr_row_end= m_curr_row_end;
+  const bool is_update= get_general_type_code() == UPDATE_ROWS_EVENT;
+  size_t n_keys= 0;
+  String keys;
+  KEY *key_info;
+
+  if (keynr >= MAX_KEY || table->versioned() ||
+      !table->file->has_transactions())
+    return;
+  key_info= table->key_info + keynr;
+  for (uint i= 0; i < key_info->user_defined_key_parts; i++)
+  {
+    uint fieldnr= key_info->key_part[i].fieldnr - 1;
+    if (fieldnr >= m_width || !bitmap_is_set(&m_cols, fieldnr))
+      return;
+  }
+
+  while (m_curr_row < m_rows_end)
+  {
+    uchar *key;
+    if (unpack_current_row(rgi) ||
+        !(key= (uchar*) keys.prep_append(key_info->key_length,
+                                         key_info->key_length * 64)))
+      goto end;
+    key_copy(key, table->record[0], key_info, 0);
+    n_keys++;
+    m_curr_row= m_curr_row_end;
+    if (is_update)
+    {
+      if (unpack_current_row(rgi, &m_cols_ai))
+        goto end;
+      m_curr_row= m_curr_row_end;
+    }
+  }
+  if (n_keys >= RPL_ROW_PREFETCH_MIN_ROWS)
+    global_rpl_row_prefetch_pool.request(table, keynr, (uchar*) keys.ptr(),
+                                         n_keys);
+
+end:
+  m_curr_row= curr_row;
+  m_curr_row_end= curr_row_end;
+}
+
+
+/**
+  Fetch the row located by the hash scan for the current row of the event
+  into @c m_table->record[0].
+
+  @returns Error code on failure, HA_ERR_END_OF_FILE if the table has no
+  row matching the current row (like a table scan), 0 on success.
+*/
+int Rows_log_event::find_row_by_hash_scan(rpl_group_info *rgi)
+{
+  Rows_hash_scan *scan= m_hash_scan;
+  TABLE *table= m_table;
+  int error;
+  DBUG_ENTER("Rows_log_event::find_row_by_hash_scan");
+
+  /* Rows are applied in event order; skipped ones are passed over */
+  while (scan->next_row < scan->rows.elements() &&
+         scan->rows.at(scan->next_row).row < m_curr_row)
+    scan->next_row++;
+  if (scan->next_row == scan->rows.elements() ||
+      scan->rows.at(scan->next_row).row != m_curr_row ||
+      !scan->rows.at(scan->next_row).found)
+  {
+    DBUG_PRINT("info", ("Record not found"));
+    DBUG_RETURN(HA_ERR_END_OF_FILE);
+  }
+
+  if (unlikely((error= table->file->ha_rnd_init_with_error(0))))
+    DBUG_RETURN(error);
+  if (unlikely((error= table->file->ha_rnd_pos(table->record[0],
+                                               scan->refs + scan->next_row *
+                                               scan->ref_length))))
+  {
+    DBUG_PRINT("info",("rnd_pos returns error %d",error));
+    if (error == HA_ERR_KEY_NOT_FOUND)
+      error= row_not_found_error(rgi);
+    table->file->print_error(error, MYF(0));
+    table->file->ha_rnd_end();
+  }
+  scan->next_row++;
+  DBUG_RETURN(error);
+}
+
+
+void Rows_log_event::free_hash_scan()
+{
+  delete m_hash_scan;
+  m_hash_scan= NULL;
+}
+
+
+/**
+  Unpack the before image of the current row into @c m_table->record[0]
+  the way it is expected to be stored in the table.
+
+  @returns Error code from unpacking the row.
+*/
+int Rows_log_event::unpack_before_image(rpl_group_info *rgi)
+{
+  TABLE *table= m_table;
+  int error;
 
   /*
     rpl_row_tabledefs.test specifies that
@@ -7799,6 +8081,52 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
     }
     table->file->column_bitmaps_signal();
   }
+  return error;
+}
+
+
+/**
+  Locate the current row in event's table.
+
+  The current row is pointed by @c m_curr_row. Member @c m_width tells
+  how many columns are there in the row (this can be differnet from
+  the number of columns in the table). It is assumed that event's
+  table is already open and pointed by @c m_table.
+
+  If a corresponding record is found in the table it is stored in 
+  @c m_table->record[0]. Note that when record is located based on a primary 
+  key, it is possible that the record found differs from the row being located.
+
+  If no key is specified or table does not have keys, a table scan is used to 
+  find the row. In that case the row should be complete and contain values for
+  all columns. However, it can still be shorter than the table, i.e. the table 
+  can contain extra columns not present in the row. It is also possible that 
+  the table has fewer columns than the row being located. 
+
+  @returns Error code on failure, 0 on success. 
+  
+  @post In case of success @c m_table->record[0] contains the record found. 
+  Also, the internal "cursor" of the table is positioned at the record found.
+
+  @note If the engine allows random access of the records, a combination of
+  @c position() and @c rnd_pos() will be used. 
+
+  Note that one MUST call ha_index_or_rnd_end() after this function if
+  it returns 0 as we must leave the row position in the handler intact
+  for any following update/delete command.
+*/
+
+int Rows_log_event::find_row(rpl_group_info *rgi)
+{
+  DBUG_ENTER("Rows_log_event::find_row");
+
+  DBUG_ASSERT(m_table && m_table->in_use != NULL);
+
+  TABLE *table= m_table;
+  int error= 0;
+  bool is_table_scan= false, is_index_scan= false;
+
+  error= unpack_before_image(rgi);
 
   DBUG_PRINT("info",("looking for the following record"));
   DBUG_DUMP("record[0]", table->record[0], table->s->reclength);
@@ -7853,6 +8181,23 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
    */ 
   store_record(table,record[1]);    
 
+  if (!m_key_info &&
+      (slave_rows_search_algorithms_options & (1ULL << SLAVE_ROWS_HASH_SCAN)))
+  {
+    /*
+      Without a usable index, locate all rows of the event in one table
+      scan the first time we get here, and fetch them by position after.
+    */
+    if (!m_hash_scan && (error= init_hash_scan(rgi)))
+      goto end;
+    if (m_hash_scan->is_usable())
+    {
+      DBUG_PRINT("info",("locating record using hash scan (rnd_pos)"));
+      error= find_row_by_hash_scan(rgi);
+      goto end;
+    }
+  }
+
   if (m_key_info)
   {
     DBUG_PRINT("info",("locating record using key #%u [%s] (index_read)",
@@ -8103,6 +8448,7 @@ Delete_rows_log_event::do_after_row_operations(const Slave_reporting_capability
   my_free(m_key);
   m_key= NULL;
   m_key_info= NULL;
+  free_hash_scan();
 
   return error;
 }
@@ -8253,6 +8599,7 @@ Update_rows_log_event::do_after_row_operations(const Slave_reporting_capability
   my_free(m_key); // Free for multi_malloc
   m_key= NULL;
   m_key_info= NULL;
+  free_hash_scan();
 
   return error;
 }
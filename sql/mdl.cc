@@ -171,6 +171,8 @@ class MDL_map
   void init();
   void destroy();
   MDL_lock *find_or_insert(LF_PINS *pins, const MDL_key *key);
+  MDL_lock *find_or_insert_fast_path(LF_PINS *pins, const MDL_key *key,
+                                     uint64_t increment);
   unsigned long get_lock_owner(LF_PINS *pins, const MDL_key *key);
   void remove(LF_PINS *pins, MDL_lock *lock);
   LF_PINS *get_pins() { return lf_hash_get_pins(&m_locks); }
@@ -340,6 +342,18 @@ class MDL_lock
 {
 public:
   typedef mdl_bitmap_t bitmap_t;
+  /**
+    Type of m_fast_path_state: counters of locks granted through the fast
+    path, FAST_PATH_COUNTER_BITS bits each, followed by flags.
+  */
+  typedef uint64_t fast_path_state_t;
+  static constexpr uint FAST_PATH_COUNTER_BITS= 20;
+  static constexpr fast_path_state_t FAST_PATH_COUNTER_MASK=
+    (1ULL << FAST_PATH_COUNTER_BITS) - 1;
+  /** Obtrusive locks are granted or waited for, fast path is disabled */
+  static constexpr fast_path_state_t HAS_OBTRUSIVE= 1ULL << 60;
+  /** Object is being removed from MDL_map, fast path is disabled */
+  static constexpr fast_path_state_t IS_DESTROYED= 1ULL << 61;
 
   class Ticket_list
   {
@@ -376,6 +390,21 @@ class MDL_lock
     virtual bool needs_notification(const MDL_ticket *ticket) const = 0;
     virtual bool conflicting_locks(const MDL_ticket *ticket) const = 0;
     virtual bitmap_t hog_lock_types_bitmap() const = 0;
+    /**
+      Types of "unobtrusive" locks, i.e. the ones which are compatible
+      with each other and can be granted through the fast path.
+    */
+    virtual bitmap_t unobtrusive_types_bitmap() const
+    { return 0; }
+    /**
+      Value to add to MDL_lock::m_fast_path_state when a lock of the given
+      type is granted through the fast path, 0 for obtrusive types.
+    */
+    virtual fast_path_state_t unobtrusive_lock_increment(enum_mdl_type) const
+    { return 0; }
+    /** Types of locks counted in the given MDL_lock::m_fast_path_state */
+    virtual bitmap_t fast_path_granted_bitmap(fast_path_state_t) const
+    { return 0; }
     virtual ~MDL_lock_strategy() {}
   };
 
@@ -460,6 +489,42 @@ class MDL_lock
               MDL_BIT(MDL_EXCLUSIVE));
     }
 
+    /*
+      Locks taken by DML. S and SH have the same compatibility with
+      granted locks and share a counter.
+    */
+    virtual bitmap_t unobtrusive_types_bitmap() const
+    {
+      return (MDL_BIT(MDL_SHARED) | MDL_BIT(MDL_SHARED_HIGH_PRIO) |
+              MDL_BIT(MDL_SHARED_READ) | MDL_BIT(MDL_SHARED_WRITE));
+    }
+    virtual fast_path_state_t
+    unobtrusive_lock_increment(enum_mdl_type type) const
+    {
+      switch (type) {
+      case MDL_SHARED:
+      case MDL_SHARED_HIGH_PRIO:
+        return 1;
+      case MDL_SHARED_READ:
+        return 1ULL << FAST_PATH_COUNTER_BITS;
+      case MDL_SHARED_WRITE:
+        return 1ULL << (2 * FAST_PATH_COUNTER_BITS);
+      default:
+        return 0;
+      }
+    }
+    virtual bitmap_t fast_path_granted_bitmap(fast_path_state_t state) const
+    {
+      bitmap_t result= 0;
+      if (state & FAST_PATH_COUNTER_MASK)
+        result|= MDL_BIT(MDL_SHARED) | MDL_BIT(MDL_SHARED_HIGH_PRIO);
+      if ((state >> FAST_PATH_COUNTER_BITS) & FAST_PATH_COUNTER_MASK)
+        result|= MDL_BIT(MDL_SHARED_READ);
+      if ((state >> (2 * FAST_PATH_COUNTER_BITS)) & FAST_PATH_COUNTER_MASK)
+        result|= MDL_BIT(MDL_SHARED_WRITE);
+      return result;
+    }
+
   private:
     static const bitmap_t m_granted_incompatible[MDL_TYPE_END];
     static const bitmap_t m_waiting_incompatible[MDL_TYPE_END];
@@ -586,6 +651,43 @@ class MDL_lock
   bitmap_t hog_lock_types_bitmap() const
   { return m_strategy->hog_lock_types_bitmap(); }
 
+  /** Types of locks currently granted through the fast path. */
+  bitmap_t fast_path_granted_bitmap() const
+  {
+    return m_strategy->fast_path_granted_bitmap(
+      m_fast_path_state.load(std::memory_order_relaxed));
+  }
+
+  /** Strategy used by MDL_lock objects for the key. */
+  static const MDL_lock_strategy *get_strategy(const MDL_key *key)
+  {
+    switch (key->mdl_namespace()) {
+    case MDL_key::BACKUP:
+      return &m_backup_lock_strategy;
+    case MDL_key::SCHEMA:
+      return &m_scoped_lock_strategy;
+    default:
+      return &m_object_lock_strategy;
+    }
+  }
+
+  /**
+    Check if a request of the given type must disable the fast path while
+    it is granted or waiting.
+  */
+  static bool is_obtrusive(const MDL_lock_strategy *strategy,
+                           enum_mdl_type type)
+  {
+    bitmap_t unobtrusive= strategy->unobtrusive_types_bitmap();
+    return unobtrusive && !(unobtrusive & MDL_BIT(type));
+  }
+
+  void update_fast_path_flag();
+  bool fast_path_acquire(fast_path_state_t increment);
+  void fast_path_release(LF_PINS *pins, const MDL_ticket *ticket);
+  void materialize_fast_path_ticket(MDL_ticket *ticket);
+  bool can_be_removed();
+
 #ifndef DBUG_OFF
   bool check_if_conflicting_replication_locks(MDL_context *ctx);
 #endif
@@ -601,16 +703,26 @@ class MDL_lock
   */
   ulong m_hog_lock_count;
 
+  /**
+    Counters of unobtrusive locks granted without adding tickets to
+    m_granted, and HAS_OBTRUSIVE and IS_DESTROYED flags. Counters are
+    only incremented while no flag is set. Flags are changed under
+    m_rwlock.
+  */
+  std::atomic<fast_path_state_t> m_fast_path_state;
+
 public:
 
   MDL_lock()
     : m_hog_lock_count(0),
+      m_fast_path_state(0),
       m_strategy(0)
   { mysql_prlock_init(key_MDL_lock_rwlock, &m_rwlock); }
 
   MDL_lock(const MDL_key *key_arg)
   : key(key_arg),
     m_hog_lock_count(0),
+    m_fast_path_state(0),
     m_strategy(&m_backup_lock_strategy)
   {
     DBUG_ASSERT(key_arg->mdl_namespace() == MDL_key::BACKUP);
@@ -631,10 +743,8 @@ class MDL_lock
   {
     DBUG_ASSERT(key_arg->mdl_namespace() != MDL_key::BACKUP);
     new (&lock->key) MDL_key(key_arg);
-    if (key_arg->mdl_namespace() == MDL_key::SCHEMA)
-      lock->m_strategy= &m_scoped_lock_strategy;
-    else
-      lock->m_strategy= &m_object_lock_strategy;
+    lock->m_fast_path_state.store(0, std::memory_order_relaxed);
+    lock->m_strategy= get_strategy(key_arg);
   }
 
   const MDL_lock_strategy *m_strategy;
@@ -651,6 +761,7 @@ const MDL_lock::MDL_object_lock MDL_lock::m_object_lock_strategy;
 
 
 static MDL_map mdl_locks;
+my_bool mdl_fast_path;
 
 
 extern "C"
@@ -837,6 +948,38 @@ MDL_lock* MDL_map::find_or_insert(LF_PINS *pins, const MDL_key *mdl_key)
 }
 
 
+/**
+  Find MDL_lock object corresponding to the key, create it if it does
+  not exist, and grant an unobtrusive lock on it through the fast path.
+
+  @param increment  Value to add to MDL_lock::m_fast_path_state.
+
+  @retval non-NULL - Lock granted. MDL_lock object is not locked, but
+                     can't be destroyed until the lock is released.
+  @retval NULL     - The slow path must be used.
+*/
+
+MDL_lock* MDL_map::find_or_insert_fast_path(LF_PINS *pins,
+                                            const MDL_key *mdl_key,
+                                            uint64_t increment)
+{
+  MDL_lock *lock;
+
+  DBUG_ASSERT(mdl_key->mdl_namespace() != MDL_key::BACKUP);
+
+  while (!(lock= (MDL_lock*) lf_hash_search(&m_locks, pins, mdl_key->ptr(),
+                                            mdl_key->length())))
+    if (lf_hash_insert(&m_locks, pins, (uchar*) mdl_key) == -1)
+      return NULL;
+
+  /* The pin keeps the object from being reused for another key. */
+  if (!lock->fast_path_acquire(increment))
+    lock= NULL;
+  lf_hash_search_unpin(pins);
+  return lock;
+}
+
+
 /**
  * Return thread id of the owner of the lock, if it is owned.
  */
@@ -893,6 +1036,117 @@ void MDL_map::remove(LF_PINS *pins, MDL_lock *lock)
 }
 
 
+/**
+  Try to grant an unobtrusive lock by incrementing m_fast_path_state.
+
+  @retval true  lock granted
+  @retval false there are obtrusive locks or the object is being removed,
+                the slow path must be used
+*/
+
+bool MDL_lock::fast_path_acquire(fast_path_state_t increment)
+{
+  fast_path_state_t state= m_fast_path_state.load(std::memory_order_relaxed);
+  do
+  {
+    if (state & (HAS_OBTRUSIVE | IS_DESTROYED))
+      return false;
+    /* Counter overflow */
+    DBUG_ASSERT(((state / increment) & FAST_PATH_COUNTER_MASK) !=
+                FAST_PATH_COUNTER_MASK);
+  } while (!m_fast_path_state.compare_exchange_weak(state, state + increment));
+  return true;
+}
+
+
+/**
+  Release an unobtrusive lock granted through the fast path.
+
+  If obtrusive requests are waiting, or this is the last lock on the
+  object, fall back to m_rwlock to reschedule the waiters or to remove
+  the object from MDL_map. The lock we still hold keeps the object alive
+  until then.
+*/
+
+void MDL_lock::fast_path_release(LF_PINS *pins, const MDL_ticket *ticket)
+{
+  const fast_path_state_t decrement=
+    m_strategy->unobtrusive_lock_increment(ticket->get_type());
+  fast_path_state_t state= m_fast_path_state.load(std::memory_order_relaxed);
+
+  DBUG_ASSERT(decrement);
+  do
+  {
+    if ((state & HAS_OBTRUSIVE) || state == decrement)
+    {
+      mysql_prlock_wrlock(&m_rwlock);
+      m_fast_path_state.fetch_sub(decrement);
+      if (can_be_removed())
+        mdl_locks.remove(pins, this);
+      else
+      {
+        reschedule_waiters();
+        mysql_prlock_unlock(&m_rwlock);
+      }
+      return;
+    }
+  } while (!m_fast_path_state.compare_exchange_weak(state, state - decrement));
+}
+
+
+/**
+  Move a ticket granted through the fast path to the granted queue, so
+  that it is visible to the deadlock detector and to conflicting
+  requests.
+*/
+
+void MDL_lock::materialize_fast_path_ticket(MDL_ticket *ticket)
+{
+  mysql_prlock_wrlock(&m_rwlock);
+  m_fast_path_state.fetch_sub(
+    m_strategy->unobtrusive_lock_increment(ticket->get_type()));
+  m_granted.add_ticket(ticket);
+  mysql_prlock_unlock(&m_rwlock);
+}
+
+
+/**
+  Set or clear HAS_OBTRUSIVE according to the ticket queues.
+
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::update_fast_path_flag()
+{
+  bitmap_t unobtrusive= m_strategy->unobtrusive_types_bitmap();
+
+  if (!unobtrusive)
+    return;
+  if ((m_granted.bitmap() | m_waiting.bitmap()) & ~unobtrusive)
+    m_fast_path_state.fetch_or(HAS_OBTRUSIVE);
+  else if (m_fast_path_state.load(std::memory_order_relaxed) & HAS_OBTRUSIVE)
+    m_fast_path_state.fetch_and(~HAS_OBTRUSIVE);
+}
+
+
+/**
+  Check if the object is not used anymore and may be removed from
+  MDL_map. If so, the fast path is disabled for it.
+
+  @pre m_rwlock is write-locked.
+*/
+
+bool MDL_lock::can_be_removed()
+{
+  fast_path_state_t state= 0;
+
+  if (!is_empty())
+    return false;
+  return !m_strategy->unobtrusive_types_bitmap() ||
+         m_fast_path_state.compare_exchange_strong(state, IS_DESTROYED);
+}
+
+
 /**
   Initialize a metadata locking context.
 
@@ -903,6 +1157,7 @@ MDL_context::MDL_context()
   :
   m_owner(NULL),
   m_needs_thr_lock_abort(FALSE),
+  m_has_fast_path_locks(FALSE),
   m_waiting_for(NULL),
   m_pins(NULL)
 {
@@ -1729,6 +1984,13 @@ MDL_lock::can_grant_lock(enum_mdl_type type_arg,
   if (!ignore_lock_priority && (m_waiting.bitmap() & waiting_incompat_map))
     return false;
 
+  /*
+    Locks granted through the fast path belong to other contexts, as we
+    materialize our own before requesting an obtrusive lock.
+  */
+  if (fast_path_granted_bitmap() & granted_incompat_map)
+    return false;
+
   if (m_granted.bitmap() & granted_incompat_map)
   {
     bool can_grant= true;
@@ -1790,7 +2052,8 @@ void MDL_lock::remove_ticket(LF_PINS *pins, Ticket_list MDL_lock::*list,
 {
   mysql_prlock_wrlock(&m_rwlock);
   (this->*list).remove_ticket(ticket);
-  if (is_empty())
+  update_fast_path_flag();
+  if (can_be_removed())
     mdl_locks.remove(pins, this);
   else
   {
@@ -1984,7 +2247,9 @@ MDL_context::try_acquire_lock(MDL_request *mdl_request)
       We can't get here if we allocated a new lock object so there
       is no need to release it.
     */
-    DBUG_ASSERT(! ticket->m_lock->is_empty());
+    DBUG_ASSERT(! ticket->m_lock->is_empty() ||
+                ticket->m_lock->fast_path_granted_bitmap());
+    ticket->m_lock->update_fast_path_flag();
     mysql_prlock_unlock(&ticket->m_lock->m_rwlock);
     MDL_ticket::destroy(ticket);
   }
@@ -2069,6 +2334,44 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
                                    )))
     return TRUE;
 
+  const MDL_lock::MDL_lock_strategy *strategy= MDL_lock::get_strategy(key);
+  const MDL_lock::fast_path_state_t fast_path_increment=
+    strategy->unobtrusive_lock_increment(mdl_request->type);
+  const bool obtrusive= MDL_lock::is_obtrusive(strategy, mdl_request->type);
+
+  /*
+    Locks of connections which must be notified about conflicting lock
+    requests are never granted through the fast path, as the notifying
+    code only looks at the granted queue. Galera conflict resolution
+    needs the granted queue as well.
+  */
+  if (fast_path_increment && mdl_fast_path && !m_needs_thr_lock_abort &&
+      !WSREP_ON &&
+      (lock= mdl_locks.find_or_insert_fast_path(m_pins, key,
+                                                fast_path_increment)))
+  {
+    ticket->m_psi= mysql_mdl_create(ticket,
+                                    &mdl_request->key,
+                                    mdl_request->type,
+                                    mdl_request->duration,
+                                    MDL_ticket::GRANTED,
+                                    mdl_request->m_src_file,
+                                    mdl_request->m_src_line);
+    ticket->m_lock= lock;
+    ticket->m_is_fast_path= true;
+    m_has_fast_path_locks= true;
+    m_tickets[mdl_request->duration].push_front(ticket);
+    mdl_request->ticket= ticket;
+    return FALSE;
+  }
+
+  /*
+    Before checking an obtrusive request against the fast path counters,
+    make sure none of them are ours.
+  */
+  if (obtrusive && m_has_fast_path_locks)
+    materialize_fast_path_locks();
+
   /* The below call implicitly locks MDL_lock::m_rwlock on success. */
   if (!(lock= mdl_locks.find_or_insert(m_pins, key)))
   {
@@ -2087,6 +2390,10 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
 
   ticket->m_lock= lock;
 
+  /* Stop new fast path grants before looking at the counters. */
+  if (obtrusive)
+    lock->m_fast_path_state.fetch_or(MDL_lock::HAS_OBTRUSIVE);
+
   if (lock->can_grant_lock(mdl_request->type, this, false))
   {
     lock->m_granted.add_ticket(ticket);
@@ -2269,6 +2576,7 @@ MDL_context::acquire_lock(MDL_request *mdl_request, double lock_wait_timeout)
 
   if (lock_wait_timeout == 0)
   {
+    lock->update_fast_path_flag();
     mysql_prlock_unlock(&lock->m_rwlock);
     MDL_ticket::destroy(ticket);
     my_error(ER_LOCK_WAIT_TIMEOUT, MYF(0));
@@ -2529,6 +2837,10 @@ MDL_context::upgrade_shared_lock(MDL_ticket *mdl_ticket,
       mdl_ticket->get_key()->mdl_namespace() != MDL_key::BACKUP)
     DBUG_RETURN(FALSE);
 
+  /* The ticket must be in the granted queue to be merged below. */
+  if (m_has_fast_path_locks)
+    materialize_fast_path_locks();
+
   MDL_REQUEST_INIT_BY_KEY(&mdl_xlock_request, &mdl_ticket->m_lock->key,
                           new_type, MDL_TRANSACTION);
 
@@ -2820,7 +3132,10 @@ void MDL_context::release_lock(enum_mdl_duration duration, MDL_ticket *ticket)
 
   DBUG_ASSERT(this == ticket->get_ctx());
 
-  lock->remove_ticket(m_pins, &MDL_lock::m_granted, ticket);
+  if (ticket->m_is_fast_path)
+    lock->fast_path_release(m_pins, ticket);
+  else
+    lock->remove_ticket(m_pins, &MDL_lock::m_granted, ticket);
 
   m_tickets[duration].remove(ticket);
   MDL_ticket::destroy(ticket);
@@ -2829,6 +3144,36 @@ void MDL_context::release_lock(enum_mdl_duration duration, MDL_ticket *ticket)
 }
 
 
+/**
+  Move all tickets of this context which were granted through the fast
+  path to the granted queues of their locks.
+
+  This is done before requesting an obtrusive lock, so that our own
+  locks are not mistaken for conflicting ones, and before waiting, so
+  that the deadlock detector can see all locks we hold.
+
+  @pre No MDL_lock::m_rwlock is held by this thread.
+*/
+
+void MDL_context::materialize_fast_path_locks()
+{
+  for (int i= 0; i < MDL_DURATION_END; i++)
+  {
+    Ticket_iterator it(m_tickets[i]);
+    MDL_ticket *ticket;
+
+    while ((ticket= it++))
+    {
+      if (!ticket->m_is_fast_path)
+        continue;
+      ticket->m_lock->materialize_fast_path_ticket(ticket);
+      ticket->m_is_fast_path= false;
+    }
+  }
+  m_has_fast_path_locks= false;
+}
+
+
 /**
   Release lock with explicit duration.
 
@@ -2937,6 +3282,7 @@ void MDL_ticket::downgrade_lock(enum_mdl_type type)
   m_lock->m_granted.remove_ticket(this);
   m_type= type;
   m_lock->m_granted.add_ticket(this);
+  m_lock->update_fast_path_flag();
   m_lock->reschedule_waiters();
   mysql_prlock_unlock(&m_lock->m_rwlock);
 }
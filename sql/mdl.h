@@ -747,6 +747,7 @@ class MDL_ticket : public MDL_wait_for_subgraph, public ilist_node<>
 #endif
      m_ctx(ctx_arg),
      m_lock(NULL),
+     m_is_fast_path(false),
      m_psi(NULL)
   {}
 
@@ -781,6 +782,13 @@ class MDL_ticket : public MDL_wait_for_subgraph, public ilist_node<>
   */
   MDL_lock *m_lock;
 
+  /**
+    Whether the lock was granted through the fast path, i.e. it is only
+    counted in MDL_lock::m_fast_path_state and is not present in the
+    granted queue. Context private.
+  */
+  bool m_is_fast_path;
+
   PSI_metadata_lock *m_psi;
 
 private:
@@ -956,6 +964,9 @@ class MDL_context
             will see the new value eventually.
     */
     m_needs_thr_lock_abort= needs_thr_lock_abort;
+    /* Conflicting lock requests must be able to see our locks. */
+    if (needs_thr_lock_abort && m_has_fast_path_locks)
+      materialize_fast_path_locks();
   }
   bool get_needs_thr_lock_abort() const
   {
@@ -1034,6 +1045,11 @@ class MDL_context
     FALSE - Otherwise.
   */
   bool m_needs_thr_lock_abort;
+  /**
+    TRUE if some of the tickets of this context were granted through
+    the fast path, see MDL_ticket::m_is_fast_path.
+  */
+  bool m_has_fast_path_locks;
 
   /**
     Read-write lock protecting m_waiting_for member.
@@ -1061,6 +1077,7 @@ class MDL_context
   bool try_acquire_lock_impl(MDL_request *mdl_request,
                              MDL_ticket **out_ticket);
   bool fix_pins();
+  void materialize_fast_path_locks();
 
 public:
   THD *get_thd() const { return m_owner->get_thd(); }
@@ -1074,6 +1091,9 @@ class MDL_context
   /** Inform the deadlock detector there is an edge in the wait-for graph. */
   void will_wait_for(MDL_wait_for_subgraph *waiting_for_arg)
   {
+    /* The deadlock detector must see all locks we hold. */
+    if (m_has_fast_path_locks)
+      materialize_fast_path_locks();
     mysql_prlock_wrlock(&m_LOCK_waiting_for);
     m_waiting_for=  waiting_for_arg;
     mysql_prlock_unlock(&m_LOCK_waiting_for);
@@ -1126,6 +1146,12 @@ extern "C" int thd_is_connected(MYSQL_THD thd);
 */
 extern "C" ulong max_write_lock_count;
 
+/*
+  Grant unobtrusive metadata locks (the ones taken by DML) by updating
+  counters of the lock object without locking it.
+*/
+extern my_bool mdl_fast_path;
+
 typedef int (*mdl_iterator_callback)(MDL_ticket *ticket, void *arg,
                                      bool granted);
 extern MYSQL_PLUGIN_IMPORT
@@ -457,6 +457,7 @@ ulong slave_exec_mode_options;
 ulong slave_run_triggers_for_rbr= 0;
 ulong slave_ddl_exec_mode_options= SLAVE_EXEC_MODE_IDEMPOTENT;
 ulonglong slave_type_conversions_options;
+ulonglong slave_rows_search_algorithms_options;
 ulong thread_cache_size=0;
 ulonglong binlog_cache_size=0;
 ulonglong binlog_file_cache_size=0;
@@ -526,7 +527,12 @@ ulong opt_slave_domain_parallel_threads= 0;
 ulong opt_slave_parallel_mode;
 ulong opt_binlog_commit_wait_count= 0;
 ulong opt_binlog_commit_wait_usec= 0;
+ulong opt_binlog_transaction_dependency_tracking;
+ulong opt_binlog_transaction_dependency_history_size= 25000;
+my_bool opt_binlog_gtid_index= 0;
+ulong opt_binlog_gtid_index_span_min= 65536;
 ulong opt_slave_parallel_max_queued= 131072;
+ulong opt_slave_row_prefetch_threads= 0;
 my_bool opt_gtid_ignore_duplicates= FALSE;
 uint opt_gtid_cleanup_batch_size= 64;
 
@@ -845,7 +851,7 @@ static struct my_option pfs_early_options[]=
 };
 
 PSI_file_key key_file_binlog,  key_file_binlog_cache, key_file_binlog_index,
-  key_file_binlog_index_cache, key_file_casetest,
+  key_file_binlog_index_cache, key_file_binlog_gtid_index, key_file_casetest,
   key_file_dbopt, key_file_des_key_file, key_file_ERRMSG, key_select_to_file,
   key_file_fileparser, key_file_frm, key_file_global_ddl_log, key_file_load,
   key_file_loadfile, key_file_log_event_data, key_file_log_event_info,
@@ -894,6 +900,7 @@ PSI_mutex_key key_LOCK_relaylog_end_pos;
 PSI_mutex_key key_LOCK_thread_id;
 PSI_mutex_key key_LOCK_slave_state, key_LOCK_binlog_state,
   key_LOCK_rpl_thread, key_LOCK_rpl_thread_pool, key_LOCK_parallel_entry;
+PSI_mutex_key key_LOCK_rpl_row_prefetch;
 PSI_mutex_key key_LOCK_rpl_semi_sync_master_enabled;
 PSI_mutex_key key_LOCK_binlog;
 
@@ -903,7 +910,7 @@ PSI_mutex_key key_LOCK_stats,
   key_LOCK_wakeup_ready, key_LOCK_wait_commit;
 PSI_mutex_key key_LOCK_gtid_waiting;
 
-PSI_mutex_key key_LOCK_after_binlog_sync;
+PSI_mutex_key key_LOCK_binlog_sync, key_LOCK_after_binlog_sync;
 PSI_mutex_key key_LOCK_prepare_ordered, key_LOCK_commit_ordered;
 PSI_mutex_key key_TABLE_SHARE_LOCK_share;
 PSI_mutex_key key_LOCK_ack_receiver;
@@ -975,6 +982,7 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_TABLE_SHARE_LOCK_rotation, "TABLE_SHARE::LOCK_rotation", 0},
   { &key_LOCK_error_messages, "LOCK_error_messages", PSI_FLAG_GLOBAL},
   { &key_LOCK_prepare_ordered, "LOCK_prepare_ordered", PSI_FLAG_GLOBAL},
+  { &key_LOCK_binlog_sync, "LOCK_binlog_sync", PSI_FLAG_GLOBAL},
   { &key_LOCK_after_binlog_sync, "LOCK_after_binlog_sync", PSI_FLAG_GLOBAL},
   { &key_LOCK_commit_ordered, "LOCK_commit_ordered", PSI_FLAG_GLOBAL},
   { &key_PARTITION_LOCK_auto_inc, "HA_DATA_PARTITION::LOCK_auto_inc", 0},
@@ -984,6 +992,7 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_LOCK_rpl_thread, "LOCK_rpl_thread", 0},
   { &key_LOCK_rpl_thread_pool, "LOCK_rpl_thread_pool", 0},
   { &key_LOCK_parallel_entry, "LOCK_parallel_entry", 0},
+  { &key_LOCK_rpl_row_prefetch, "LOCK_rpl_row_prefetch", 0},
   { &key_LOCK_ack_receiver, "Ack_receiver::mutex", 0},
   { &key_LOCK_rpl_semi_sync_master_enabled, "LOCK_rpl_semi_sync_master_enabled", 0},
   { &key_LOCK_binlog, "LOCK_binlog", 0}
@@ -1045,7 +1054,7 @@ PSI_cond_key key_TC_LOG_MMAP_COND_queue_busy;
 PSI_cond_key key_COND_rpl_thread_queue, key_COND_rpl_thread,
   key_COND_rpl_thread_stop, key_COND_rpl_thread_pool,
   key_COND_parallel_entry, key_COND_group_commit_orderer,
-  key_COND_prepare_ordered;
+  key_COND_prepare_ordered, key_COND_rpl_row_prefetch;
 PSI_cond_key key_COND_wait_gtid, key_COND_gtid_ignore_duplicates;
 PSI_cond_key key_COND_ack_receiver;
 
@@ -1090,6 +1099,7 @@ static PSI_cond_info all_server_conds[]=
   { &key_COND_rpl_thread_pool, "COND_rpl_thread_pool", 0},
   { &key_COND_parallel_entry, "COND_parallel_entry", 0},
   { &key_COND_group_commit_orderer, "COND_group_commit_orderer", 0},
+  { &key_COND_rpl_row_prefetch, "COND_rpl_row_prefetch", 0},
   { &key_COND_prepare_ordered, "COND_prepare_ordered", 0},
   { &key_COND_start_thread, "COND_start_thread", PSI_FLAG_GLOBAL},
   { &key_COND_wait_gtid, "COND_wait_gtid", 0},
@@ -1102,7 +1112,8 @@ static PSI_cond_info all_server_conds[]=
 PSI_thread_key key_thread_delayed_insert,
   key_thread_handle_manager, key_thread_main,
   key_thread_one_connection, key_thread_signal_hand,
-  key_thread_slave_background, key_rpl_parallel_thread;
+  key_thread_slave_background, key_rpl_parallel_thread,
+  key_rpl_row_prefetch_thread, key_thread_sort;
 PSI_thread_key key_thread_ack_receiver;
 
 static PSI_thread_info all_server_threads[]=
@@ -1114,7 +1125,9 @@ static PSI_thread_info all_server_threads[]=
   { &key_thread_signal_hand, "signal_handler", PSI_FLAG_GLOBAL},
   { &key_thread_slave_background, "slave_background", PSI_FLAG_GLOBAL},
   { &key_thread_ack_receiver, "Ack_receiver", PSI_FLAG_GLOBAL},
-  { &key_rpl_parallel_thread, "rpl_parallel_thread", 0}
+  { &key_rpl_parallel_thread, "rpl_parallel_thread", 0},
+  { &key_rpl_row_prefetch_thread, "rpl_row_prefetch_thread", 0},
+  { &key_thread_sort, "sort_thread", PSI_FLAG_GLOBAL}
 };
 
 #ifdef HAVE_MMAP
@@ -1955,6 +1968,7 @@ static void clean_up(bool print_message)
     tc_log->close();
   xid_cache_free();
   tdc_deinit();
+  filesort_thread_pool_end();
   mdl_destroy();
   dflt_key_cache= 0;
   key_caches.delete_elements(free_key_cache);
@@ -2089,6 +2103,7 @@ static void clean_up_mutexes()
   mysql_cond_destroy(&COND_server_started);
   mysql_mutex_destroy(&LOCK_prepare_ordered);
   mysql_cond_destroy(&COND_prepare_ordered);
+  mysql_mutex_destroy(&LOCK_binlog_sync);
   mysql_mutex_destroy(&LOCK_after_binlog_sync);
   mysql_mutex_destroy(&LOCK_commit_ordered);
 #ifndef EMBEDDED_LIBRARY
@@ -4191,6 +4206,8 @@ static int init_thread_environment()
   mysql_mutex_init(key_LOCK_prepare_ordered, &LOCK_prepare_ordered,
                    MY_MUTEX_INIT_SLOW);
   mysql_cond_init(key_COND_prepare_ordered, &COND_prepare_ordered, NULL);
+  mysql_mutex_init(key_LOCK_binlog_sync, &LOCK_binlog_sync,
+                   MY_MUTEX_INIT_SLOW);
   mysql_mutex_init(key_LOCK_after_binlog_sync, &LOCK_after_binlog_sync,
                    MY_MUTEX_INIT_SLOW);
   mysql_mutex_init(key_LOCK_commit_ordered, &LOCK_commit_ordered,
@@ -4575,6 +4592,7 @@ static int init_server_components()
   mdl_init();
   if (tdc_init() || hostname_cache_init())
     unireg_abort(1);
+  filesort_thread_pool_init();
 
   query_cache_set_min_res_unit(query_cache_min_res_unit);
   query_cache_result_size_limit(query_cache_limit);
@@ -9026,6 +9044,7 @@ static PSI_file_info all_server_files[]=
   { &key_file_binlog_cache, "binlog_cache", 0},
   { &key_file_binlog_index, "binlog_index", 0},
   { &key_file_binlog_index_cache, "binlog_index_cache", 0},
+  { &key_file_binlog_gtid_index, "binlog_gtid_index", 0},
   { &key_file_relaylog, "relaylog", 0},
   { &key_file_relaylog_cache, "relaylog_cache", 0},
   { &key_file_relaylog_index, "relaylog_index", 0},
@@ -69,8 +69,8 @@ static int maxmin_in_range(bool max_fl, Field* field, COND *cond);
     tables		List of tables
 
   NOTES
-    When this is called, we know all table handlers supports HA_HAS_RECORDS
-    or HA_STATS_RECORDS_IS_EXACT
+    When this is called, we know all table handlers supports HA_HAS_RECORDS,
+    HA_CAN_COUNT_ROWS or HA_STATS_RECORDS_IS_EXACT
 
   RETURN
     ULONGLONG_MAX	Error: Could not calculate number of rows
@@ -84,7 +84,9 @@ static ulonglong get_exact_record_count(List<TABLE_LIST> &tables)
   List_iterator<TABLE_LIST> ti(tables);
   while ((tl= ti++))
   {
-    ha_rows tmp= tl->table->file->records();
+    handler *file= tl->table->file;
+    ha_rows tmp= (file->ha_table_flags() & HA_HAS_RECORDS)
+      ? file->records() : file->count_rows();
     if (tmp == HA_POS_ERROR)
       return ULONGLONG_MAX;
     count*= tmp;
@@ -298,9 +300,14 @@ int opt_sum_query(THD *thd,
     if (!(tl->table->file->ha_table_flags() & HA_STATS_RECORDS_IS_EXACT) ||
         tl->schema_table)
     {
+      /*
+        handler::count_rows() reads the whole table; don't do that only
+        to EXPLAIN the query.
+      */
       maybe_exact_count&= MY_TEST(!tl->schema_table &&
                                   (tl->table->file->ha_table_flags() &
-                                   HA_HAS_RECORDS));
+                                   (thd->lex->describe ? HA_HAS_RECORDS :
+                                    HA_HAS_RECORDS | HA_CAN_COUNT_ROWS)));
       is_exact_count= FALSE;
       count= 1;                                 // ensure count != 0
     }
@@ -0,0 +1,258 @@
+/*
+  Sparse GTID index of binlog files, see rpl_gtid_index.h.
+
+  The reader is also used by mysqlbinlog, so it only uses mysys.
+*/
+
+#ifdef MYSQL_SERVER
+#include "mariadb.h"
+#include "mysqld.h"
+#include "log.h"
+#endif
+#include "rpl_gtid_index.h"
+
+
+static const uchar gtid_index_magic[4]= { 0xfe, 'G', 'I', 'X' };
+
+#define GTID_INDEX_ENTRY_HEADER_LEN 12
+#define GTID_INDEX_GTID_LEN 16
+#define GTID_INDEX_CRC_LEN 4
+
+
+static void gtid_index_file_name(char *buf, const char *binlog_name)
+{
+  strxnmov(buf, FN_REFLEN - 1, binlog_name, GTID_INDEX_EXT, NullS);
+}
+
+
+/*
+  Check whether a binlog reader that starts at the given GTID position
+  would skip every event group written before an index entry with the
+  given GTIDs (same rules as the binlog dump thread): within a domain of
+  the position, event groups from other server_ids are skipped, and those
+  of the same server_id up to and including the position. The position
+  itself must lie after the entry, so that it is still found.
+*/
+static bool gtid_index_entry_before(const uchar *gtids, uint32 count,
+                                    const rpl_gtid *pos, uint32 pos_count)
+{
+  for (uint32 i= 0; i < count; i++, gtids+= GTID_INDEX_GTID_LEN)
+  {
+    uint32 domain_id= uint4korr(gtids);
+    uint32 server_id= uint4korr(gtids + 4);
+    uint64 seq_no= uint8korr(gtids + 8);
+    const rpl_gtid *p= pos;
+    const rpl_gtid *pos_end= pos + pos_count;
+
+    while (p < pos_end && p->domain_id != domain_id)
+      p++;
+    if (p == pos_end ||
+        (p->server_id == server_id && seq_no >= p->seq_no))
+      return false;
+  }
+  return true;
+}
+
+
+/*
+  Find where to start reading a binlog file to reach a GTID position.
+
+  @param binlog_name  Binlog file, its index is binlog_name + GTID_INDEX_EXT
+  @param max_offset   Only consider entries up to this binlog offset, ie.
+                      the part of the binlog known to be written
+  @param pos          The GTID position, at most one GTID per domain_id
+  @param pos_count    Number of GTIDs in pos
+
+  @return The binlog offset of the last index entry with only GTIDs before
+  pos, or 0 if there is none (or no usable index), in which case the binlog
+  must be read from the start.
+*/
+my_off_t gtid_index_find_start(const char *binlog_name, my_off_t max_offset,
+                               const rpl_gtid *pos, uint32 pos_count)
+{
+  char name[FN_REFLEN];
+  uchar header[GTID_INDEX_HEADER_LEN];
+  uchar *buf= NULL;
+  size_t buf_size= 0;
+  my_off_t found= 0, last= 0;
+  File file;
+
+  gtid_index_file_name(name, binlog_name);
+  if ((file= my_open(name, O_RDONLY | O_BINARY, MYF(0))) < 0)
+    return 0;
+  if (my_read(file, header, sizeof(header), MYF(MY_NABP)) ||
+      memcmp(header, gtid_index_magic, sizeof(gtid_index_magic)) ||
+      uint4korr(header + 4) != GTID_INDEX_VERSION)
+    goto end;
+
+  for (;;)
+  {
+    uchar entry_header[GTID_INDEX_ENTRY_HEADER_LEN];
+    my_off_t offset;
+    uint32 count;
+    size_t len;
+
+    if (my_read(file, entry_header, sizeof(entry_header), MYF(MY_NABP)))
+      break;
+    offset= uint8korr(entry_header);
+    count= uint4korr(entry_header + 8);
+    len= (size_t) count * GTID_INDEX_GTID_LEN + GTID_INDEX_CRC_LEN;
+    if (offset <= last || offset > max_offset || !count ||
+        count > GTID_INDEX_MAX_GTIDS)
+      break;
+    if (len > buf_size)
+    {
+      uchar *new_buf= (uchar *) my_realloc(PSI_NOT_INSTRUMENTED, buf, len,
+                                           MYF(MY_ALLOW_ZERO_PTR));
+      if (!new_buf)
+        break;
+      buf= new_buf;
+      buf_size= len;
+    }
+    if (my_read(file, buf, len, MYF(MY_NABP)) ||
+        my_checksum(my_checksum(0, entry_header, sizeof(entry_header)),
+                    buf, len - GTID_INDEX_CRC_LEN) !=
+        uint4korr(buf + len - GTID_INDEX_CRC_LEN) ||
+        !gtid_index_entry_before(buf, count, pos, pos_count))
+      break;
+    found= last= offset;
+  }
+
+end:
+  my_free(buf);
+  my_close(file, MYF(0));
+  return found;
+}
+
+
+#ifdef MYSQL_SERVER
+
+/* Remove the index of a binlog file that is purged, if there is one. */
+bool gtid_index_delete(const char *binlog_name)
+{
+  char name[FN_REFLEN];
+  gtid_index_file_name(name, binlog_name);
+  if (mysql_file_delete(key_file_binlog_gtid_index, name, MYF(0)) &&
+      my_errno != ENOENT)
+    return true;
+  my_errno= 0;
+  return false;
+}
+
+
+Gtid_index_writer::Gtid_index_writer()
+  : file(-1), span_min(0), last_offset(0)
+{
+  /* No initial allocation, this runs in the constructor of mysql_bin_log */
+  my_init_dynamic_array(PSI_INSTRUMENT_ME, &gtids, sizeof(rpl_gtid), 0, 16,
+                        MYF(0));
+}
+
+
+Gtid_index_writer::~Gtid_index_writer()
+{
+  close();
+  delete_dynamic(&gtids);
+}
+
+
+/*
+  Start the index of a newly created binlog file. A failure is reported
+  to the error log, and the binlog file is then written without index.
+*/
+bool Gtid_index_writer::open(const char *binlog_name, my_off_t span)
+{
+  char name[FN_REFLEN];
+  uchar header[GTID_INDEX_HEADER_LEN];
+
+  close();
+  gtid_index_file_name(name, binlog_name);
+  if ((file= mysql_file_create(key_file_binlog_gtid_index, name, CREATE_MODE,
+                               O_WRONLY | O_TRUNC | O_BINARY,
+                               MYF(MY_WME))) < 0)
+  {
+    sql_print_warning("Could not create GTID index '%s', binlog file will "
+                      "not be indexed", name);
+    return true;
+  }
+  memcpy(header, gtid_index_magic, sizeof(gtid_index_magic));
+  int4store(header + 4, GTID_INDEX_VERSION);
+  if (mysql_file_write(file, header, sizeof(header), MYF(MY_WME|MY_NABP)))
+  {
+    close();
+    return true;
+  }
+  span_min= span;
+  last_offset= 0;
+  return false;
+}
+
+
+void Gtid_index_writer::close()
+{
+  if (file >= 0)
+  {
+    mysql_file_close(file, MYF(0));
+    file= -1;
+  }
+  reset_dynamic(&gtids);
+}
+
+
+/*
+  Called at the start of each event group, with the binlog offset it will
+  be written at. Appends an entry to the index if the binlog has grown by
+  at least span_min since the last one.
+*/
+void Gtid_index_writer::event_group_start(my_off_t offset)
+{
+  uchar *buf, *p;
+  size_t len;
+
+  if (file < 0 || offset < last_offset + span_min || !gtids.elements)
+    return;
+  len= GTID_INDEX_ENTRY_HEADER_LEN + gtids.elements * GTID_INDEX_GTID_LEN +
+       GTID_INDEX_CRC_LEN;
+  if (!(buf= (uchar *) my_malloc(PSI_INSTRUMENT_ME, len, MYF(0))))
+    return;
+  int8store(buf, (ulonglong) offset);
+  int4store(buf + 8, gtids.elements);
+  p= buf + GTID_INDEX_ENTRY_HEADER_LEN;
+  for (uint i= 0; i < gtids.elements; i++, p+= GTID_INDEX_GTID_LEN)
+  {
+    const rpl_gtid *gtid= dynamic_element(&gtids, i, rpl_gtid *);
+    int4store(p, gtid->domain_id);
+    int4store(p + 4, gtid->server_id);
+    int8store(p + 8, gtid->seq_no);
+  }
+  int4store(p, my_checksum(0, buf, len - GTID_INDEX_CRC_LEN));
+  if (mysql_file_write(file, buf, len, MYF(MY_WME|MY_NABP)))
+  {
+    sql_print_warning("Error writing GTID index, the rest of the binlog "
+                      "file will not be indexed");
+    close();
+  }
+  last_offset= offset;
+  my_free(buf);
+}
+
+
+void Gtid_index_writer::gtid_written(const rpl_gtid *gtid)
+{
+  if (file < 0)
+    return;
+  for (uint i= 0; i < gtids.elements; i++)
+  {
+    rpl_gtid *last= dynamic_element(&gtids, i, rpl_gtid *);
+    if (last->domain_id == gtid->domain_id &&
+        last->server_id == gtid->server_id)
+    {
+      last->seq_no= gtid->seq_no;
+      return;
+    }
+  }
+  if (gtids.elements >= GTID_INDEX_MAX_GTIDS || insert_dynamic(&gtids, gtid))
+    close();
+}
+
+#endif /* MYSQL_SERVER */
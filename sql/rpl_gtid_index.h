@@ -0,0 +1,72 @@
+#ifndef RPL_GTID_INDEX_H
+#define RPL_GTID_INDEX_H
+
+#include "rpl_gtid.h"
+
+/*
+  Sparse GTID index of a binlog file.
+
+  With --binlog-gtid-index, every binlog file gets an index file with the
+  same name plus GTID_INDEX_EXT. Whenever at least
+  --binlog-gtid-index-span-min bytes have been written to the binlog since
+  the last entry, an entry is appended at the start of the next event group.
+  It holds the binlog offset of that event group and, for every
+  (domain_id, server_id), the last GTID written to this binlog file before
+  it. A reader that wants to start at a GTID position can then seek to the
+  last entry that has only GTIDs before that position, instead of reading
+  the binlog file from the start.
+
+  The index is only a hint. It is not synced, so after a crash it may miss
+  entries or point past the end of the binlog, which readers check for.
+  Every entry has its own checksum, so that a torn write at the end of the
+  index is ignored.
+
+  The file starts with GTID_INDEX_HEADER_LEN bytes of magic and version,
+  followed by the entries, all little-endian:
+
+    8 bytes     binlog offset
+    4 bytes     number n of GTIDs
+    n*16 bytes  domain_id (4 bytes), server_id (4 bytes), seq_no (8 bytes)
+    4 bytes     CRC32 of the above
+*/
+
+#define GTID_INDEX_EXT ".idx"
+#define GTID_INDEX_HEADER_LEN 8
+#define GTID_INDEX_VERSION 1
+/*
+  Most GTIDs in one entry. A binlog file rarely has more than a few
+  (domain_id, server_id) pairs, so a count above this is taken as a corrupt
+  entry without allocating a buffer for it. Past this, the rest of the
+  binlog file is not indexed.
+*/
+#define GTID_INDEX_MAX_GTIDS 65536
+
+
+my_off_t gtid_index_find_start(const char *binlog_name, my_off_t max_offset,
+                               const rpl_gtid *pos, uint32 pos_count);
+
+#ifdef MYSQL_SERVER
+bool gtid_index_delete(const char *binlog_name);
+
+
+class Gtid_index_writer
+{
+public:
+  Gtid_index_writer();
+  ~Gtid_index_writer();
+  bool open(const char *binlog_name, my_off_t span_min);
+  void close();
+  bool is_open() const { return file >= 0; }
+  void event_group_start(my_off_t offset);
+  void gtid_written(const rpl_gtid *gtid);
+
+private:
+  File file;
+  my_off_t span_min;
+  my_off_t last_offset;
+  /* Last GTID written to the binlog file, per (domain_id, server_id) */
+  DYNAMIC_ARRAY gtids;
+};
+#endif
+
+#endif  /* RPL_GTID_INDEX_H */
@@ -0,0 +1,283 @@
+#include "mariadb.h"
+#include "rpl_row_prefetch.h"
+#include "sql_class.h"
+#include "sql_base.h"
+#include "handler.h"
+#include "transaction.h"
+
+/*
+  Code for prefetching the rows of replicated row events on the slave,
+  see rpl_row_prefetch.h.
+*/
+
+
+rpl_row_prefetch_pool global_rpl_row_prefetch_pool;
+
+
+/*
+  Read the rows of one request through the primary key, so that their pages
+  end up in the buffer pool. Errors are ignored; the worker that applies the
+  event will run into them itself if they matter.
+*/
+static void
+prefetch_rows(THD *thd, rpl_row_prefetch_thread *rpt,
+              rpl_row_prefetch_request *req)
+{
+  Query_tables_list lex_backup;
+  TABLE_LIST tlist;
+
+  thd->reset_for_next_command();
+  thd->lex->reset_n_backup_query_tables_list(&lex_backup);
+  tlist.init_one_table(&req->db, &req->table_name, NULL, TL_READ);
+  if (!open_and_lock_tables(thd, &tlist, FALSE, 0))
+  {
+    TABLE *table= tlist.table;
+    if (req->keynr == table->s->primary_key &&
+        req->key_length == table->key_info[req->keynr].key_length)
+    {
+      table->use_all_columns();
+      if (!table->file->ha_index_init(req->keynr, 0))
+      {
+        const uchar *key= req->keys;
+        for (size_t i= 0; i < req->n_keys && !rpt->stop && !thd->killed; i++)
+        {
+          table->file->ha_index_read_map(table->record[0], key,
+                                         HA_WHOLE_KEY, HA_READ_KEY_EXACT);
+          key+= req->key_length;
+        }
+        table->file->ha_index_end();
+      }
+    }
+    ha_commit_trans(thd, FALSE);
+  }
+  thd->clear_error();
+  close_thread_tables(thd);
+  ha_commit_trans(thd, TRUE);
+  thd->release_transactional_locks();
+  thd->lex->restore_backup_query_tables_list(&lex_backup);
+}
+
+
+pthread_handler_t
+handle_rpl_row_prefetch_thread(void *arg)
+{
+  THD *thd;
+  rpl_row_prefetch_thread *rpt= (rpl_row_prefetch_thread *)arg;
+
+  my_thread_init();
+  thd= new THD(next_thread_id());
+  thd->thread_stack= (char*)&thd;
+  server_threads.insert(thd);
+  set_current_thd(thd);
+  pthread_detach_this_thread();
+  thd->store_globals();
+  thd->init_for_queries();
+  init_thr_lock();
+  thd->system_thread= SYSTEM_THREAD_SLAVE_BACKGROUND;
+  thd->security_ctx->skip_grants();
+  thd->set_command(COM_DAEMON);
+  thd->variables.wsrep_on= 0;
+  thd->variables.option_bits&=
+    ~(ulonglong)(OPTION_NOT_AUTOCOMMIT | OPTION_BEGIN | OPTION_BIN_LOG);
+  /*
+    The rows are only read to bring them into memory. Do not take row locks
+    or build old row versions for that, and give up quickly on metadata
+    locks, eg. if DDL is waiting for the table.
+  */
+  thd->variables.tx_isolation= ISO_READ_UNCOMMITTED;
+  thd->variables.lock_wait_timeout= 1;
+  thd_proc_info(thd, "Waiting for rows to prefetch");
+
+  mysql_mutex_lock(&rpt->LOCK_prefetch);
+  rpt->thd= thd;
+  rpt->running= true;
+  mysql_cond_broadcast(&rpt->COND_prefetch);
+  for (;;)
+  {
+    rpl_row_prefetch_request *list;
+
+    while (!rpt->stop && !rpt->first)
+      mysql_cond_wait(&rpt->COND_prefetch, &rpt->LOCK_prefetch);
+    list= rpt->first;
+    rpt->first= NULL;
+    rpt->last_ptr= &rpt->first;
+    rpt->queued_size= 0;
+    mysql_mutex_unlock(&rpt->LOCK_prefetch);
+
+    thd_proc_info(thd, "Prefetching rows for replicated row events");
+    while (list)
+    {
+      rpl_row_prefetch_request *next= list->next;
+      if (!rpt->stop)
+        prefetch_rows(thd, rpt, list);
+      my_free(list);
+      list= next;
+    }
+    thd_proc_info(thd, "Waiting for rows to prefetch");
+
+    mysql_mutex_lock(&rpt->LOCK_prefetch);
+    if (rpt->stop && !rpt->first)
+      break;
+  }
+  rpt->thd= NULL;
+  mysql_mutex_unlock(&rpt->LOCK_prefetch);
+
+  thd->clear_error();
+  thd->catalog= 0;
+  thd->reset_query();
+  thd->reset_db(&null_clex_str);
+  server_threads.erase(thd);
+  delete thd;
+
+  mysql_mutex_lock(&rpt->LOCK_prefetch);
+  rpt->running= false;
+  mysql_cond_broadcast(&rpt->COND_prefetch);
+  mysql_mutex_unlock(&rpt->LOCK_prefetch);
+
+  my_thread_end();
+  return NULL;
+}
+
+
+bool
+rpl_row_prefetch_pool::init(uint thread_count)
+{
+  if (!thread_count)
+    return false;
+  if (!(threads= (rpl_row_prefetch_thread *)
+        my_malloc(PSI_INSTRUMENT_ME, thread_count * sizeof(*threads),
+                  MYF(MY_WME|MY_ZEROFILL))))
+    return true;
+
+  for (uint i= 0; i < thread_count; i++)
+  {
+    rpl_row_prefetch_thread *rpt= &threads[i];
+    pthread_t th;
+
+    mysql_mutex_init(key_LOCK_rpl_row_prefetch, &rpt->LOCK_prefetch,
+                     MY_MUTEX_INIT_SLOW);
+    mysql_cond_init(key_COND_rpl_row_prefetch, &rpt->COND_prefetch, NULL);
+    rpt->last_ptr= &rpt->first;
+    count= i + 1;
+    mysql_mutex_lock(&rpt->LOCK_prefetch);
+    if (mysql_thread_create(key_rpl_row_prefetch_thread, &th,
+                            &connection_attrib,
+                            handle_rpl_row_prefetch_thread, rpt))
+    {
+      mysql_mutex_unlock(&rpt->LOCK_prefetch);
+      sql_print_error("Failed to create slave row prefetch thread");
+      destroy();
+      return true;
+    }
+    while (!rpt->running)
+      mysql_cond_wait(&rpt->COND_prefetch, &rpt->LOCK_prefetch);
+    mysql_mutex_unlock(&rpt->LOCK_prefetch);
+  }
+  return false;
+}
+
+
+void
+rpl_row_prefetch_pool::destroy()
+{
+  for (uint i= 0; i < count; i++)
+  {
+    rpl_row_prefetch_thread *rpt= &threads[i];
+
+    mysql_mutex_lock(&rpt->LOCK_prefetch);
+    rpt->stop= true;
+    mysql_cond_broadcast(&rpt->COND_prefetch);
+    while (rpt->running)
+      mysql_cond_wait(&rpt->COND_prefetch, &rpt->LOCK_prefetch);
+    mysql_mutex_unlock(&rpt->LOCK_prefetch);
+    mysql_cond_destroy(&rpt->COND_prefetch);
+    mysql_mutex_destroy(&rpt->LOCK_prefetch);
+  }
+  my_free(threads);
+  threads= NULL;
+  count= 0;
+}
+
+
+/*
+  Queue the rows with the given primary key images (key_copy() format, one
+  after the other) for prefetch.
+
+  The keys are sharded over the helper threads by hash, so the same row is
+  always read by the same helper and each helper reads its part of the event
+  in the order the worker will apply it.
+*/
+void
+rpl_row_prefetch_pool::request(TABLE *table, uint keynr, const uchar *keys,
+                               size_t n_keys)
+{
+  uint key_length= table->key_info[keynr].key_length;
+  const LEX_CSTRING &db= table->s->db;
+  const LEX_CSTRING &table_name= table->s->table_name;
+  size_t *shard_keys;
+  uint *shard_of;
+  const uchar *key;
+
+  if (!my_multi_malloc(PSI_INSTRUMENT_ME, MYF(MY_ZEROFILL),
+                       &shard_keys, count * sizeof(*shard_keys),
+                       &shard_of, n_keys * sizeof(*shard_of),
+                       NULL))
+    return;
+  key= keys;
+  for (size_t i= 0; i < n_keys; i++, key+= key_length)
+  {
+    shard_of[i]= (uint) (my_checksum(0, key, key_length) % count);
+    shard_keys[shard_of[i]]++;
+  }
+
+  for (uint t= 0; t < count; t++)
+  {
+    rpl_row_prefetch_thread *rpt= &threads[t];
+    rpl_row_prefetch_request *req;
+    char *db_str, *table_name_str;
+    uchar *req_keys;
+    size_t size= shard_keys[t] * key_length;
+
+    if (!shard_keys[t])
+      continue;
+    if (!my_multi_malloc(PSI_INSTRUMENT_ME, MYF(0),
+                         &req, sizeof(*req),
+                         &db_str, db.length + 1,
+                         &table_name_str, table_name.length + 1,
+                         &req_keys, size,
+                         NULL))
+      break;
+    req->next= NULL;
+    req->db.str= strmake(db_str, db.str, db.length) - db.length;
+    req->db.length= db.length;
+    req->table_name.str= strmake(table_name_str, table_name.str,
+                                 table_name.length) - table_name.length;
+    req->table_name.length= table_name.length;
+    req->keynr= keynr;
+    req->key_length= key_length;
+    req->n_keys= shard_keys[t];
+    req->keys= req_keys;
+    key= keys;
+    for (size_t i= 0; i < n_keys; i++, key+= key_length)
+    {
+      if (shard_of[i] == t)
+      {
+        memcpy(req_keys, key, key_length);
+        req_keys+= key_length;
+      }
+    }
+
+    mysql_mutex_lock(&rpt->LOCK_prefetch);
+    if (rpt->stop || rpt->queued_size + size > opt_slave_parallel_max_queued)
+      my_free(req);
+    else
+    {
+      *rpt->last_ptr= req;
+      rpt->last_ptr= &req->next;
+      rpt->queued_size+= size;
+      mysql_cond_signal(&rpt->COND_prefetch);
+    }
+    mysql_mutex_unlock(&rpt->LOCK_prefetch);
+  }
+  my_free(shard_keys);
+}
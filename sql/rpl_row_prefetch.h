@@ -0,0 +1,74 @@
+#ifndef RPL_ROW_PREFETCH_H
+#define RPL_ROW_PREFETCH_H
+
+/*
+  Prefetch of the rows modified by replicated row events.
+
+  A large transaction is applied by a single worker thread, one row at a
+  time, and every row lookup that misses the buffer pool stalls the worker
+  on a page read. The transaction itself cannot be spread over several
+  threads, as its engine transaction belongs to the THD of the worker. But
+  the rows it is going to modify are known in advance from the row events.
+
+  When --slave-row-prefetch-threads is set, the worker hands the primary
+  keys of the rows of each Update_rows and Delete_rows event on a table
+  with row-level locking to a pool of helper threads before applying it,
+  sharded by key. The helpers read those rows in their own (non-locking)
+  transactions, so that the pages are in the buffer pool by the time the
+  worker gets to them. Prefetch is only a hint; requests are dropped when
+  the helpers fall behind.
+
+  The keys are those of the event the worker is about to apply, so only the
+  page reads within an event overlap. The worker reads the first rows of the
+  event itself; the helpers, which do nothing but read, get ahead of it on
+  the rest.
+*/
+
+#include "mysql/psi/mysql_thread.h"
+
+struct TABLE;
+class THD;
+
+/* Events with fewer rows than this are applied without prefetch. */
+#define RPL_ROW_PREFETCH_MIN_ROWS 4
+
+struct rpl_row_prefetch_request
+{
+  rpl_row_prefetch_request *next;
+  LEX_CSTRING db;
+  LEX_CSTRING table_name;
+  uint keynr;
+  uint key_length;
+  size_t n_keys;
+  uchar *keys;
+};
+
+
+struct rpl_row_prefetch_thread
+{
+  mysql_mutex_t LOCK_prefetch;
+  mysql_cond_t COND_prefetch;
+  THD *thd;
+  rpl_row_prefetch_request *first, **last_ptr;
+  /* Bytes of requests queued, bounded by slave_parallel_max_queued. */
+  size_t queued_size;
+  bool running;
+  bool stop;
+};
+
+
+struct rpl_row_prefetch_pool
+{
+  rpl_row_prefetch_thread *threads;
+  uint count;
+
+  rpl_row_prefetch_pool() : threads(NULL), count(0) {}
+  bool init(uint thread_count);
+  void destroy();
+  bool enabled() const { return count != 0; }
+  void request(TABLE *table, uint keynr, const uchar *keys, size_t n_keys);
+};
+
+extern rpl_row_prefetch_pool global_rpl_row_prefetch_pool;
+
+#endif  /* RPL_ROW_PREFETCH_H */
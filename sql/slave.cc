@@ -65,6 +65,7 @@ Master_info_index *master_info_index;
 #include "rpl_tblmap.h"
 #include "debug_sync.h"
 #include "rpl_parallel.h"
+#include "rpl_row_prefetch.h"
 #include "sql_show.h"
 #include "semisync_slave.h"
 #include "sql_manager.h"
@@ -566,6 +567,8 @@ int init_slave()
 
   if (global_rpl_thread_pool.init(opt_slave_parallel_threads))
     return 1;
+  if (global_rpl_row_prefetch_pool.init(opt_slave_row_prefetch_threads))
+    return 1;
 
   slave_background_thread_gtid_loaded= false;
   mysql_manager_submit(bg_rpl_load_gtid_slave_state, NULL);
@@ -1299,6 +1302,7 @@ void slave_prepare_for_shutdown()
   // It's safe to destruct worker pool now when
   // all driver threads are gone.
   global_rpl_thread_pool.deactivate();
+  global_rpl_row_prefetch_pool.destroy();
 }
 
 /*
@@ -1330,6 +1334,7 @@ void end_slave()
   mysql_mutex_unlock(&LOCK_active_mi);
 
   global_rpl_thread_pool.destroy();
+  global_rpl_row_prefetch_pool.destroy();
   free_all_rpl_filters();
   DBUG_VOID_RETURN;
 }
@@ -276,7 +276,7 @@ static my_bool list_open_tables_callback(TDC_element *element,
   All_share_tables_list::Iterator it(element->all_tables);
   TABLE *table;
   while ((table= it++))
-    if (table->in_use)
+    if (tc_table_in_use(table))
       ++(*arg->start_list)->in_use;
   mysql_mutex_unlock(&element->LOCK_table_share);
   (*arg->start_list)->locked= 0;                   /* Obsolete. */
@@ -588,15 +588,20 @@ void inline fix_local_query_cache_mode(THD *thd)
   @param mode TIMEOUT the lock can abort because of a timeout
               TRY the lock can abort because it is locked now
               WAIT wait for lock (default)
+  @param shared Take the lock in LOCKED_SHARED mode, which is compatible
+              with other shared lockers. A shared lock is not granted
+              while an exclusive lock is being waited for, or while a
+              table that a cache hit found to be stale is waiting to be
+              invalidated.
 
   @note mode is optional and default value is WAIT.
 
   @return
-   @retval FALSE An exclusive lock was taken
+   @retval FALSE The lock was taken
    @retval TRUE The locking attempt failed
 */
 
-bool Query_cache::try_lock(THD *thd, Cache_try_lock_mode mode)
+bool Query_cache::try_lock(THD *thd, Cache_try_lock_mode mode, bool shared)
 {
   bool interrupt= TRUE;
   Query_cache_wait_state wait_state(thd, __func__, __FILE__, __LINE__);
@@ -614,7 +619,17 @@ bool Query_cache::try_lock(THD *thd, Cache_try_lock_mode mode)
 
   while (1)
   {
-    if (m_cache_lock_status == Query_cache::UNLOCKED)
+    if (shared &&
+        (m_cache_lock_status == Query_cache::UNLOCKED ||
+         m_cache_lock_status == Query_cache::LOCKED_SHARED) &&
+        !m_exclusive_lock_waiters && !m_pending_invalidations)
+    {
+      m_cache_lock_status= Query_cache::LOCKED_SHARED;
+      m_cache_lock_readers++;
+      interrupt= FALSE;
+      break;
+    }
+    else if (!shared && m_cache_lock_status == Query_cache::UNLOCKED)
     {
       m_cache_lock_status= Query_cache::LOCKED;
 #ifndef DBUG_OFF
@@ -633,21 +648,27 @@ bool Query_cache::try_lock(THD *thd, Cache_try_lock_mode mode)
     }
     else
     {
-      DBUG_ASSERT(m_cache_lock_status == Query_cache::LOCKED);
+      DBUG_ASSERT(m_cache_lock_status == Query_cache::LOCKED ||
+                  m_cache_lock_status == Query_cache::LOCKED_SHARED ||
+                  (shared && m_cache_lock_status == Query_cache::UNLOCKED));
       /*
         To prevent send_result_to_client() and query_cache_insert() from
         blocking execution for too long a timeout is put on the lock.
       */
       if (mode == WAIT)
       {
+        m_exclusive_lock_waiters+= !shared;
         mysql_cond_wait(&COND_cache_status_changed, &structure_guard_mutex);
+        m_exclusive_lock_waiters-= !shared;
       }
       else if (mode == TIMEOUT)
       {
         struct timespec waittime;
         set_timespec_nsec(waittime,50000000UL);  /* Wait for 50 msec */
+        m_exclusive_lock_waiters+= !shared;
         int res= mysql_cond_timedwait(&COND_cache_status_changed,
                                       &structure_guard_mutex, &waittime);
+        m_exclusive_lock_waiters-= !shared;
         if (res == ETIMEDOUT)
           break;
       }
@@ -692,7 +713,11 @@ void Query_cache::lock_and_suspend(void)
   mysql_mutex_lock(&structure_guard_mutex);
   m_requests_in_progress++;
   while (m_cache_lock_status != Query_cache::UNLOCKED)
+  {
+    m_exclusive_lock_waiters++;
     mysql_cond_wait(&COND_cache_status_changed, &structure_guard_mutex);
+    m_exclusive_lock_waiters--;
+  }
   m_cache_lock_status= Query_cache::LOCKED_NO_WAIT;
 #ifndef DBUG_OFF
   /* Here thd may not be set during shutdown */
@@ -723,7 +748,11 @@ void Query_cache::lock(THD *thd)
   m_requests_in_progress++;
   fix_local_query_cache_mode(thd);
   while (m_cache_lock_status != Query_cache::UNLOCKED)
+  {
+    m_exclusive_lock_waiters++;
     mysql_cond_wait(&COND_cache_status_changed, &structure_guard_mutex);
+    m_exclusive_lock_waiters--;
+  }
   m_cache_lock_status= Query_cache::LOCKED;
 #ifndef DBUG_OFF
   m_cache_lock_thread_id= thd->thread_id;
@@ -735,24 +764,40 @@ void Query_cache::lock(THD *thd)
 
 
 /**
-  Set the query cache to UNLOCKED and signal waiting threads.
+  Release the lock on the query cache. The cache becomes UNLOCKED and the
+  waiting threads are signalled when the last shared locker leaves.
 */
 
 void Query_cache::unlock(void)
 {
   DBUG_ENTER("Query_cache::unlock");
   mysql_mutex_lock(&structure_guard_mutex);
+  if (m_cache_lock_status == Query_cache::LOCKED_SHARED)
+  {
+    DBUG_ASSERT(m_cache_lock_readers > 0);
+    if (--m_cache_lock_readers == 0)
+      m_cache_lock_status= Query_cache::UNLOCKED;
+  }
+  else
+  {
 #ifndef DBUG_OFF
-  /* Thd may not be set in resize() at mysqld start */
-  THD *thd= current_thd;
-  if (thd)
-    DBUG_ASSERT(m_cache_lock_thread_id == thd->thread_id);
+    /* Thd may not be set in resize() at mysqld start */
+    THD *thd= current_thd;
+    if (thd)
+      DBUG_ASSERT(m_cache_lock_thread_id == thd->thread_id);
 #endif
-  DBUG_ASSERT(m_cache_lock_status == Query_cache::LOCKED ||
-              m_cache_lock_status == Query_cache::LOCKED_NO_WAIT);
-  m_cache_lock_status= Query_cache::UNLOCKED;
-  DBUG_PRINT("Query_cache",("Sending signal"));
-  mysql_cond_signal(&COND_cache_status_changed);
+    DBUG_ASSERT(m_cache_lock_status == Query_cache::LOCKED ||
+                m_cache_lock_status == Query_cache::LOCKED_NO_WAIT);
+    m_cache_lock_status= Query_cache::UNLOCKED;
+  }
+  if (m_cache_lock_status == Query_cache::UNLOCKED)
+  {
+    /*
+      Wake up all waiters: several shared lockers may proceed together.
+    */
+    DBUG_PRINT("Query_cache",("Sending signal"));
+    mysql_cond_broadcast(&COND_cache_status_changed);
+  }
   DBUG_ASSERT(m_requests_in_progress > 0);
   m_requests_in_progress--;
   if (m_requests_in_progress == 0 && m_cache_status == DISABLE_REQUEST)
@@ -1714,6 +1759,8 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
   size_t tot_length;
   Query_cache_query_flags flags;
   const char *sql, *sql_end, *found_brace= 0;
+  uchar *invalidate_key= 0;
+  size_t invalidate_key_length= 0;
   DBUG_ENTER("Query_cache::send_result_to_client");
 
   /*
@@ -1870,13 +1917,13 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
     }
   }
   /*
-    Try to obtain an exclusive lock on the query cache. If the cache is
+    Try to obtain a shared lock on the query cache. If the cache is
     disabled or if a full cache flush is in progress, the attempt to
     get the lock is aborted.
 
     The TIMEOUT parameter indicate that the lock is allowed to timeout.
   */
-  if (try_lock(thd, Query_cache::TIMEOUT))
+  if (try_lock(thd, Query_cache::TIMEOUT, true))
     goto err;
 
   if (query_cache_size == 0)
@@ -1996,7 +2043,7 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
     unlock();
     if (wsrep_sync_wait(thd))
       goto err;
-    if (try_lock(thd, Query_cache::TIMEOUT))
+    if (try_lock(thd, Query_cache::TIMEOUT, true))
       goto err;
     once_more= false;
     goto lookup;
@@ -2110,8 +2157,12 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
                                                table->suffix_length(),
                                                table->suffix_length());
    
-      if (!(*table->callback())(thd, qcache_se_key_name,
-                                (uint)qcache_se_key_len, &engine_data))
+      my_bool permitted= (*table->callback())(thd, qcache_se_key_name,
+                                              (uint)qcache_se_key_len,
+                                              &engine_data);
+      DBUG_EXECUTE_IF("qcache_engine_requires_invalidation",
+                      { permitted= FALSE; engine_data++; });
+      if (!permitted)
       {
         DBUG_PRINT("qcache", ("Handler does not allow caching for %.*s",
                               (int)qcache_se_key_len, qcache_se_key_name));
@@ -2122,9 +2173,18 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
                      ("Handler require invalidation queries of %.*s %llu-%llu",
                       (int)qcache_se_key_len, qcache_se_key_name,
                       engine_data, table->engine_data()));
-          invalidate_table_internal(thd,
-                                    (uchar *) table->db(),
-                                    table->key_length());
+          /*
+            The cache is only locked in shared mode; the table is
+            invalidated after the lock has been released. Until then no
+            new hit may be served, as it could return the result that
+            the engine has just refused.
+          */
+          invalidate_key_length= table->key_length();
+          invalidate_key= (uchar *) thd->memdup(table->db(),
+                                                invalidate_key_length);
+          mysql_mutex_lock(&structure_guard_mutex);
+          m_pending_invalidations++;
+          mysql_mutex_unlock(&structure_guard_mutex);
         }
         else
         {
@@ -2148,9 +2208,15 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
       DBUG_PRINT("qcache", ("handler allow caching %s,%s",
 			    table_list.db.str, table_list.alias.str));
   }
+  /*
+    Other hits may be served concurrently under the shared lock, so the
+    query list and the counters are updated under structure_guard_mutex.
+  */
+  mysql_mutex_lock(&structure_guard_mutex);
   move_to_query_list_end(query_block);
   hits++;
   query->increment_hits();
+  mysql_mutex_unlock(&structure_guard_mutex);
   unlock();
 
   /*
@@ -2205,6 +2271,19 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
 
 err_unlock:
   unlock();
+  if (invalidate_key)
+  {
+    DEBUG_SYNC(thd, "wait_before_query_cache_deferred_invalidate");
+    lock(thd);
+    if (query_cache_size > 0)
+      invalidate_table_internal(thd, invalidate_key, invalidate_key_length);
+    /* Hits are allowed again when unlock() wakes up the waiters. */
+    mysql_mutex_lock(&structure_guard_mutex);
+    DBUG_ASSERT(m_pending_invalidations > 0);
+    m_pending_invalidations--;
+    mysql_mutex_unlock(&structure_guard_mutex);
+    unlock();
+  }
   MYSQL_QUERY_CACHE_MISS(thd->query());
   /*
     query_plan_flags doesn't have to be changed here as it contains
@@ -2545,6 +2624,9 @@ void Query_cache::init()
   mysql_cond_init(key_COND_cache_status_changed,
                   &COND_cache_status_changed, NULL);
   m_cache_lock_status= Query_cache::UNLOCKED;
+  m_cache_lock_readers= 0;
+  m_exclusive_lock_waiters= 0;
+  m_pending_invalidations= 0;
   m_cache_status= Query_cache::OK;
   m_requests_in_progress= 0;
   initialized = 1;
@@ -313,8 +313,17 @@ class Query_cache
 #endif
   mysql_cond_t COND_cache_status_changed;
   uint m_requests_in_progress;
-  enum Cache_lock_status { UNLOCKED, LOCKED_NO_WAIT, LOCKED };
+  enum Cache_lock_status { UNLOCKED, LOCKED_NO_WAIT, LOCKED, LOCKED_SHARED };
   Cache_lock_status m_cache_lock_status;
+  /* Number of threads holding the lock in LOCKED_SHARED mode */
+  uint m_cache_lock_readers;
+  /* Number of threads waiting for an exclusive lock */
+  uint m_exclusive_lock_waiters;
+  /*
+    Number of tables that a cache hit found to be stale and that are not
+    invalidated yet; no shared lock is granted while this is not 0
+  */
+  uint m_pending_invalidations;
   enum Cache_staus {OK, DISABLE_REQUEST, DISABLED};
   Cache_staus m_cache_status;
 
@@ -330,6 +339,12 @@ class Query_cache
       1. structure_guard_mutex
       2. query block (for operation inside query (query block/results))
 
+    Cache hits only read the query hash and the tables of the found query,
+    so send_result_to_client() locks the cache in LOCKED_SHARED mode and
+    hits are served concurrently. The query list and the hit counters,
+    which are updated on a hit, are then protected by
+    structure_guard_mutex itself.
+
     Thread doing cache flush releases the mutex once it sets
     m_cache_lock_status flag, so other threads may bypass the cache as
     if it is disabled, not waiting for reset to finish.  The exception
@@ -536,7 +551,8 @@ class Query_cache
 				    uint32 *db_langth);
 
   enum Cache_try_lock_mode {WAIT, TIMEOUT, TRY};
-  bool try_lock(THD *thd, Cache_try_lock_mode mode= WAIT);
+  bool try_lock(THD *thd, Cache_try_lock_mode mode= WAIT,
+                bool shared= false);
   void lock(THD *thd);
   void lock_and_suspend(void);
   void unlock(void);
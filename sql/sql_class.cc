@@ -794,6 +794,8 @@ THD::THD(my_thread_id id, bool is_wsrep_applier)
   semisync_info= 0;
   db_charset= global_system_variables.collation_database;
   bzero((void*) ha_data, sizeof(ha_data));
+  bzero((void*) tc_thread_tables, sizeof(tc_thread_tables));
+  tc_thread_next_slot= 0;
   mysys_var=0;
   binlog_evt_union.do_union= FALSE;
   binlog_table_maps= FALSE;
@@ -1550,6 +1552,7 @@ void THD::cleanup(void)
 
   DBUG_ASSERT(open_tables == NULL);
   DBUG_ASSERT(m_transaction_psi == NULL);
+  tc_release_thread_tables(this);
 
   /*
     If the thread was in the middle of an ongoing transaction (rolled
@@ -111,6 +111,9 @@ enum enum_slave_run_triggers_for_rbr { SLAVE_RUN_TRIGGERS_FOR_RBR_NO,
                                        SLAVE_RUN_TRIGGERS_FOR_RBR_ENFORCE};
 enum enum_slave_type_conversions { SLAVE_TYPE_CONVERSIONS_ALL_LOSSY,
                                    SLAVE_TYPE_CONVERSIONS_ALL_NON_LOSSY};
+enum enum_slave_rows_search_algorithms { SLAVE_ROWS_TABLE_SCAN,
+                                         SLAVE_ROWS_INDEX_SCAN,
+                                         SLAVE_ROWS_HASH_SCAN };
 
 /*
   MARK_COLUMNS_READ:  A column is goind to be read.
@@ -676,6 +679,7 @@ typedef struct system_variables
   ulong max_length_for_sort_data;
   ulong max_recursive_iterations;
   ulong max_sort_length;
+  ulong max_sort_threads;
   ulong max_tmp_tables;
   ulong max_insert_delayed_threads;
   ulong min_examined_row_limit;
@@ -743,6 +747,7 @@ typedef struct system_variables
   my_bool low_priority_updates;
   my_bool query_cache_wlock_invalidate;
   my_bool keep_files_on_create;
+  my_bool join_buffer_grow;
 
   my_bool old_mode;
   my_bool old_passwords;
@@ -4891,6 +4896,16 @@ class THD: public THD_count, /* this must be first */
 
 
   LF_PINS *tdc_hash_pins;
+  /**
+    TABLE objects released by this thread and kept for reuse without
+    locking the table cache, see tc_park_table(). Only this thread
+    accesses the slots; the objects may be evicted by other threads.
+  */
+  TABLE *tc_thread_tables[TC_THREAD_SLOTS_MAX];
+  /* Hash values of the table keys of tc_thread_tables */
+  my_hash_value_type tc_thread_hash_values[TC_THREAD_SLOTS_MAX];
+  /* Slot to free when all slots are taken */
+  uint tc_thread_next_slot;
   LF_PINS *xid_hash_pins;
   bool fix_xid_hash_pins();
 
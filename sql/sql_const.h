@@ -140,6 +140,8 @@
 #define TABLE_OPEN_CACHE_MIN    200
 #define TABLE_OPEN_CACHE_DEFAULT 2000
 #define TABLE_DEF_CACHE_DEFAULT 400
+/* Maximum number of TABLE objects a thread keeps for reuse */
+#define TC_THREAD_SLOTS_MAX 16
 /**
   We must have room for at least 400 table definitions in the table
   cache, since otherwise there is no chance prepared
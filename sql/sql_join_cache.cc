@@ -993,6 +993,67 @@ bool JOIN_CACHE::shrink_join_buffer_in_ratio(ulonglong n, ulonglong d)
 }  
 
 
+/*
+  Enlarge the join buffer of a join cache after it has been filled up
+
+  SYNOPSIS
+    grow_buffer()
+
+  DESCRIPTION
+    Every time the join buffer gets full all records of the joined table
+    have to be read again. If join_buffer_grow is set, the function doubles
+    the size of the buffer, but does not let the total size of all join
+    buffers of the query exceed join_buffer_space_limit. The records in the
+    buffer must have been processed, so that the buffer can be replaced with
+    an empty one. This is only done for BNL and BNLH caches without blobs:
+    BKA caches pass parts of the buffer to MRR, and blob values of the last
+    record may point into the buffer.
+    The buffer does not grow beyond the largest size that the offsets
+    chosen for its original size can address.
+    If the memory cannot be allocated, the current buffer is kept.
+*/
+
+void JOIN_CACHE::grow_buffer()
+{
+  if (!join->thd->variables.join_buffer_grow || blobs ||
+      (get_join_alg() != BNL_JOIN_ALG && get_join_alg() != BNLH_JOIN_ALG))
+    return;
+
+  ulonglong space= 0;
+  for (JOIN_TAB *tab= first_linear_tab(join, WITH_BUSH_ROOTS,
+                                       WITHOUT_CONST_TABLES);
+       tab;
+       tab= next_linear_tab(join, tab, WITH_BUSH_ROOTS))
+  {
+    if (tab->cache)
+      space+= tab->cache->get_join_buffer_size();
+  }
+  ulonglong limit= join->thd->variables.join_buff_space_limit;
+  if (space >= limit)
+    return;
+  size_t new_size= (size_t) MY_MIN((ulonglong) buff_size * 2,
+                                   buff_size + (limit - space));
+  /*
+    The sizes of the offsets into the buffer, also those stored by the next
+    caches and by the hash table, were chosen by init() for the original
+    buffer size. Stay within the sizes they can address.
+  */
+  if (size_of_rec_ofs < 4)
+    set_if_smaller(new_size, ((size_t) 1 << (8 * size_of_rec_ofs)) - 1);
+  else
+    set_if_smaller(new_size, (size_t) UINT_MAX32);
+  uchar *new_buff;
+  if (new_size <= buff_size ||
+      !(new_buff= (uchar*) my_malloc(key_memory_JOIN_CACHE, new_size,
+                                     MYF(MY_THREAD_SPECIFIC))))
+    return;
+  free();
+  buff= new_buff;
+  buff_size= new_size;
+  init_new_buffer();
+}
+
+
 /*
   Reallocate the join buffer of a join cache
  
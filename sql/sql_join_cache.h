@@ -369,6 +369,9 @@ class JOIN_CACHE :public Sql_alloc
 
   /* Shall reallocate the join buffer */
   virtual int realloc_buffer();
+
+  /* Prepare a newly allocated, empty join buffer for writing */
+  virtual void init_new_buffer() { reset(TRUE); }
   
   /* Check the possibility to read the access keys directly from join buffer */ 
   bool check_emb_key_usage();
@@ -615,6 +618,9 @@ class JOIN_CACHE :public Sql_alloc
   /* Shrink the size if the cache join buffer in a given ratio */
   bool shrink_join_buffer_in_ratio(ulonglong n, ulonglong d);
 
+  /* Enlarge the join buffer after it has been filled up and emptied */
+  void grow_buffer();
+
   /*  Shall return the type of the employed join algorithm */
   virtual enum Join_algorithm get_join_alg()= 0;
 
@@ -984,6 +990,12 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* Reallocate the join buffer of a hashed join cache */
   int realloc_buffer();
 
+  void init_new_buffer()
+  {
+    init_hash_table();
+    reset(TRUE);
+  }
+
   /* 
     This constructor creates an unlinked hashed join cache. The cache is to be
     used to join table 'tab' to the result of joining the previous tables 
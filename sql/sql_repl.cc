@@ -26,6 +26,7 @@
 #include "sql_repl.h"
 #include "log_event.h"
 #include "rpl_filter.h"
+#include "rpl_gtid_index.h"
 #include <my_dir.h>
 #include "debug_sync.h"
 #include "semisync_master.h"
@@ -2105,6 +2106,56 @@ static int check_start_offset(binlog_send_info *info,
   return info->error;
 }
 
+/*
+  Find where a slave connecting with GTID can start in the binlog file found
+  by gtid_find_binlog_file(), using the GTID index of that file if there is
+  one (see rpl_gtid_index.h). Without a usable index entry, the file is read
+  from the start as usual.
+
+  START SLAVE UNTIL and slave positions in domains not in the binlog of this
+  master need the events from the start of the file, so always start there
+  for those.
+*/
+static my_off_t gtid_index_start_pos(binlog_send_info *info,
+                                     const char *log_file_name)
+{
+  slave_connection_state *gtid_state= &info->gtid_state;
+  uint32 count= (uint32) gtid_state->count();
+  char end_pos_file[FN_REFLEN];
+  my_off_t end_pos, start_pos;
+  rpl_gtid *gtid_list;
+  MY_STAT stat;
+
+  if (!opt_binlog_gtid_index || info->until_gtid_state || !count)
+    return BIN_LOG_HEADER_SIZE;
+  for (uint32 i= 0; i < count; i++)
+  {
+    slave_connection_state::entry *e= (slave_connection_state::entry *)
+      my_hash_element(&gtid_state->hash, i);
+    if (e->flags & slave_connection_state::START_ON_EMPTY_DOMAIN)
+      return BIN_LOG_HEADER_SIZE;
+  }
+
+  /* Only seek into the part of the active binlog that is already written. */
+  mysql_bin_log.lock_binlog_end_pos();
+  end_pos= mysql_bin_log.get_binlog_end_pos(end_pos_file);
+  mysql_bin_log.unlock_binlog_end_pos();
+  if (!mysql_file_stat(key_file_binlog, log_file_name, &stat, MYF(0)))
+    return BIN_LOG_HEADER_SIZE;
+  if (strcmp(end_pos_file, log_file_name) != 0 ||
+      end_pos > (my_off_t) stat.st_size)
+    end_pos= (my_off_t) stat.st_size;
+
+  if (!(gtid_list= (rpl_gtid *) my_malloc(PSI_INSTRUMENT_ME,
+                                          count * sizeof(*gtid_list),
+                                          MYF(0))))
+    return BIN_LOG_HEADER_SIZE;
+  gtid_state->get_gtid_list(gtid_list, count);
+  start_pos= gtid_index_find_start(log_file_name, end_pos, gtid_list, count);
+  my_free(gtid_list);
+  return start_pos > BIN_LOG_HEADER_SIZE ? start_pos : BIN_LOG_HEADER_SIZE;
+}
+
 static int init_binlog_sender(binlog_send_info *info,
                               LOG_INFO *linfo,
                               const char *log_ident,
@@ -2227,6 +2278,9 @@ static int init_binlog_sender(binlog_send_info *info,
     return 1;
   }
 
+  if (info->using_gtid_state)
+    *pos= gtid_index_start_pos(info, linfo->log_file_name);
+
   // set current pos too
   linfo->pos= *pos;
   // note: publish that we use file, before we open it
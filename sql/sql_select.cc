@@ -3066,7 +3066,7 @@ int JOIN::optimize_stage2()
 
     if (select_lex->have_window_funcs())
     {
-      if (!(join_tab= (JOIN_TAB*) thd->alloc(sizeof(JOIN_TAB))))
+      if (!(join_tab= (JOIN_TAB*) thd->calloc(sizeof(JOIN_TAB))))
         DBUG_RETURN(1);
       need_tmp= 1;
     }
@@ -4131,6 +4131,8 @@ JOIN::reinit()
          tab= next_linear_tab(this, tab, WITH_BUSH_ROOTS))
     {
       tab->ref.key_err= TRUE;
+      if (tab->cond_prefilter)
+        tab->cond_prefilter->reset();
     }
   }
 
@@ -20617,6 +20619,8 @@ sub_select_cache(JOIN *join, JOIN_TAB *join_tab, bool end_of_records)
       extensions for all records in the buffer.
     */ 
     rc= cache->join_records(FALSE);
+    if (rc == NESTED_LOOP_OK)
+      cache->grow_buffer();
     DBUG_RETURN(rc);
   }
   /*
@@ -20876,6 +20880,193 @@ sub_select(JOIN *join,JOIN_TAB *join_tab,bool end_of_records)
   DBUG_RETURN(rc);
 }
 
+/* @return the column, if item is a plain integer column */
+
+static Field *cond_prefilter_field(Item *item)
+{
+  if (item->type() != Item::FIELD_ITEM)
+    return NULL;
+  Field *field= ((Item_field*) item)->field;
+  switch (field->type()) {
+  case MYSQL_TYPE_TINY:
+  case MYSQL_TYPE_SHORT:
+  case MYSQL_TYPE_INT24:
+  case MYSQL_TYPE_LONG:
+  case MYSQL_TYPE_LONGLONG:
+    return field;
+  default:
+    return NULL;
+  }
+}
+
+
+/*
+  @return whether item is an integer constant. Its value is read by
+  Cond_int_prefilter::read_consts() in each execution.
+*/
+
+static bool cond_prefilter_const(Item *item)
+{
+  return item->type() == Item::CONST_ITEM && item->cmp_type() == INT_RESULT;
+}
+
+
+/* Compile one conjunct. @return false if it is not supported */
+
+bool Cond_int_prefilter::add(Item *item)
+{
+  if (item->type() != Item::FUNC_ITEM)
+    return false;
+  Item_func *func= (Item_func*) item;
+  Item **args= func->arguments();
+  Check *c= &checks[n_checks];
+  c->negated= false;
+  c->b_item= NULL;
+
+  switch (func->functype()) {
+  case Item_func::EQ_FUNC:
+  case Item_func::NE_FUNC:
+  case Item_func::LT_FUNC:
+  case Item_func::LE_FUNC:
+  case Item_func::GE_FUNC:
+  case Item_func::GT_FUNC:
+  {
+    Item_bool_rowready_func2 *cmp= (Item_bool_rowready_func2*) func;
+    if (cmp->compare_type_handler()->cmp_type() != INT_RESULT)
+      return false;
+    if ((c->field= cond_prefilter_field(args[0])) &&
+        cond_prefilter_const(args[1]))
+    {
+      c->op= cmp->functype();
+      c->a_item= args[1];
+    }
+    else if ((c->field= cond_prefilter_field(args[1])) &&
+             cond_prefilter_const(args[0]))
+    {
+      c->op= cmp->rev_functype();
+      c->a_item= args[0];
+    }
+    else
+      return false;
+    break;
+  }
+  case Item_func::BETWEEN:
+  {
+    Item_func_between *between= (Item_func_between*) func;
+    if (between->compare_type_handler()->cmp_type() != INT_RESULT ||
+        !(c->field= cond_prefilter_field(args[0])) ||
+        !cond_prefilter_const(args[1]) || !cond_prefilter_const(args[2]))
+      return false;
+    c->op= Item_func::BETWEEN;
+    c->a_item= args[1];
+    c->b_item= args[2];
+    c->negated= between->negated;
+    break;
+  }
+  default:
+    return false;
+  }
+  c->field_unsigned= ((Field_num*) c->field)->unsigned_flag;
+  n_checks++;
+  return true;
+}
+
+
+/*
+  Compile the prefilter of a table condition.
+  @return NULL if the condition does not start with a supported conjunct
+*/
+
+Cond_int_prefilter *Cond_int_prefilter::create(THD *thd, COND *cond)
+{
+  List<Item> single;
+  List<Item> *conjuncts= &single;
+  if (cond->type() == Item::COND_ITEM &&
+      ((Item_cond*) cond)->functype() == Item_func::COND_AND_FUNC)
+  {
+    /* Without abort_on_null, AND goes on after a NULL conjunct */
+    if (!((Item_cond*) cond)->top_level())
+      return NULL;
+    conjuncts= ((Item_cond*) cond)->argument_list();
+  }
+  else if (single.push_back(cond, thd->mem_root))
+    return NULL;
+
+  Cond_int_prefilter *filter= new (thd->mem_root) Cond_int_prefilter;
+  if (!filter ||
+      !(filter->checks= (Check*) thd->alloc(conjuncts->elements *
+                                            sizeof(Check))))
+    return NULL;
+  filter->n_checks= 0;
+  List_iterator_fast<Item> it(*conjuncts);
+  Item *item;
+  while ((item= it++) && filter->add(item))
+  {}
+  if (!filter->n_checks)
+    return NULL;
+  filter->complete= filter->n_checks == conjuncts->elements;
+  filter->consts_read= false;
+  return filter;
+}
+
+
+void Cond_int_prefilter::read_consts()
+{
+  has_null_const= false;
+  for (Check *c= checks, *end= checks + n_checks; c != end; c++)
+  {
+    c->a= c->a_item->val_int();
+    c->a_unsigned= c->a_item->unsigned_flag;
+    has_null_const|= c->a_item->null_value;
+    if (c->b_item)
+    {
+      c->b= c->b_item->val_int();
+      c->b_unsigned= c->b_item->unsigned_flag;
+      has_null_const|= c->b_item->null_value;
+    }
+  }
+  consts_read= true;
+}
+
+
+int Cond_int_prefilter::check()
+{
+  if (!consts_read)
+    read_consts();
+  /*
+    A comparison with NULL is not true, but NOT BETWEEN can still be,
+    so leave such conditions to the Item tree.
+  */
+  if (has_null_const)
+    return 0;
+  for (const Check *c= checks, *end= checks + n_checks; c != end; c++)
+  {
+    /* A comparison with a NULL value is not true */
+    if (c->field->is_null())
+      return -1;
+    Longlong_hybrid value(c->field->val_int(), c->field_unsigned);
+    int cmp= value.cmp(Longlong_hybrid(c->a, c->a_unsigned));
+    bool res;
+    switch (c->op) {
+    case Item_func::EQ_FUNC: res= cmp == 0; break;
+    case Item_func::NE_FUNC: res= cmp != 0; break;
+    case Item_func::LT_FUNC: res= cmp < 0; break;
+    case Item_func::LE_FUNC: res= cmp <= 0; break;
+    case Item_func::GE_FUNC: res= cmp >= 0; break;
+    case Item_func::GT_FUNC: res= cmp > 0; break;
+    default:
+      DBUG_ASSERT(c->op == Item_func::BETWEEN);
+      res= (cmp >= 0 &&
+            value.cmp(Longlong_hybrid(c->b, c->b_unsigned)) <= 0) !=
+        c->negated;
+    }
+    if (!res)
+      return -1;
+  }
+  return complete;
+}
+
+
 /**
   @brief Process one row of the nested loop join.
 
@@ -20920,11 +21111,28 @@ evaluate_join_record(JOIN *join, JOIN_TAB *join_tab,
 
   if (select_cond)
   {
-    select_cond_result= MY_TEST(select_cond->val_int());
+    int prefilter_result= 0;
+    if (optimizer_flag(join->thd, OPTIMIZER_SWITCH_COND_PREFILTER))
+    {
+      if (join_tab->cond_prefilter_for != select_cond)
+      {
+        join_tab->cond_prefilter= Cond_int_prefilter::create(join->thd,
+                                                             select_cond);
+        join_tab->cond_prefilter_for= select_cond;
+      }
+      if (join_tab->cond_prefilter)
+        prefilter_result= join_tab->cond_prefilter->check();
+    }
+    if (prefilter_result)
+      select_cond_result= prefilter_result > 0;
+    else
+    {
+      select_cond_result= MY_TEST(select_cond->val_int());
 
-    /* check for errors evaluating the condition */
-    if (unlikely(join->thd->is_error()))
-      DBUG_RETURN(NESTED_LOOP_ERROR);
+      /* check for errors evaluating the condition */
+      if (unlikely(join->thd->is_error()))
+        DBUG_RETURN(NESTED_LOOP_ERROR);
+    }
   }
 
   if (!select_cond || select_cond_result)
@@ -250,6 +250,53 @@ class Filesort;
 struct SplM_plan_info;
 class SplM_opt_info;
 
+/*
+  The leading conjuncts of a table condition that compare an integer
+  column with an integer constant (=, <>, <, <=, >, >=, [NOT] BETWEEN),
+  compiled into a flat array. Rows that fail them are rejected without
+  walking the Item tree, which costs several virtual calls per Item.
+  Only a prefix of the conjuncts is compiled, so that rejecting a row
+  never skips an Item that the full condition would have evaluated.
+  Used when optimizer_switch='condition_prefilter=on'.
+
+  The constants may be parameters of a prepared statement or SP
+  variables, so their values are read once per execution of the join,
+  see reset().
+*/
+
+class Cond_int_prefilter :public Sql_alloc
+{
+  struct Check
+  {
+    Field *field;
+    Item_func::Functype op;
+    Item *a_item, *b_item;
+    bool field_unsigned, negated, a_unsigned, b_unsigned;
+    longlong a, b;
+  };
+  Check *checks;
+  uint n_checks;
+  /* Whether the compiled conjuncts are the whole condition */
+  bool complete;
+  /* Whether the constants have been read in this execution */
+  bool consts_read;
+  /* Whether a constant is NULL, so that the Item tree must decide */
+  bool has_null_const;
+
+  bool add(Item *item);
+  void read_consts();
+public:
+  static Cond_int_prefilter *create(THD *thd, COND *cond);
+  /* Read the constants again before checking the next row */
+  void reset() { consts_read= false; }
+  /*
+    @retval -1 the current row does not satisfy the condition
+    @retval  0 the full condition must be evaluated
+    @retval  1 the current row satisfies the condition
+  */
+  int check();
+};
+
 typedef struct st_join_table {
   TABLE		*table;
   TABLE_LIST    *tab_list;
@@ -258,6 +305,9 @@ typedef struct st_join_table {
                                     not supported by any index               */
   SQL_SELECT	*select;
   COND		*select_cond;
+  /* The prefilter of select_cond, compiled for cond_prefilter_for */
+  Cond_int_prefilter *cond_prefilter;
+  COND          *cond_prefilter_for;
   COND          *on_precond;    /**< part of on condition to check before
                                      accessing the first inner table         */
   QUICK_SELECT_I *quick;
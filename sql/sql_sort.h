@@ -559,6 +559,8 @@ class Sort_param {
   Addon_fields *addon_fields;     // Descriptors for companion fields.
   Sort_keys *sort_keys;
   bool using_pq;
+  uint max_threads;           // Max threads for sorting a buffer
+  uint sort_threads;          // Max threads actually used for a buffer
 
   uchar *unique_buff;
   bool not_killable;
@@ -1302,6 +1302,13 @@ static Sys_var_ulong Sys_interactive_timeout(
        CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(1, LONG_TIMEOUT), DEFAULT(NET_WAIT_TIMEOUT), BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_join_buffer_grow(
+       "join_buffer_grow",
+       "Let a full block nested loop join buffer (BNL, BNLH) double its "
+       "size, within join_buffer_space_limit for all join buffers of the "
+       "query, so that large joins need fewer scans of the joined table",
+       SESSION_VAR(join_buffer_grow), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 static Sys_var_ulonglong Sys_join_buffer_size(
        "join_buffer_size",
        "The size of the buffer that is used for joins",
@@ -1761,6 +1768,14 @@ static Sys_var_ulong Sys_metadata_locks_hash_instances(
        VALID_RANGE(1, 1024), DEFAULT(8),
        BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_metadata_locks_fast_path(
+       "metadata_locks_fast_path",
+       "Grant the shared metadata locks taken by DML statements by "
+       "updating counters of the lock object instead of locking it, as "
+       "long as no DDL holds or waits for a conflicting lock. Such locks "
+       "are not shown in METADATA_LOCK_INFO",
+       GLOBAL_VAR(mdl_fast_path), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 static Sys_var_on_access_session<Sys_var_ulonglong,
                                  PRIV_SET_SYSTEM_SESSION_VAR_PSEUDO_THREAD_ID>
 Sys_pseudo_thread_id(
@@ -2240,6 +2255,19 @@ Sys_slave_parallel_max_queued(
        VALID_RANGE(0,2147483647), DEFAULT(131072), BLOCK_SIZE(1));
 
 
+static Sys_var_ulong Sys_slave_row_prefetch_threads(
+       "slave_row_prefetch_threads",
+       "If non-zero, number of threads to spawn on the slave that read ahead "
+       "the rows modified by Update_rows and Delete_rows events on "
+       "transactional tables with a primary key, sharded by key, so that the "
+       "thread applying a large transaction finds them in memory. The "
+       "prefetch requests of each thread are limited by "
+       "--slave-parallel-max-queued.",
+       READ_ONLY GLOBAL_VAR(opt_slave_row_prefetch_threads),
+       CMD_LINE(REQUIRED_ARG), VALID_RANGE(0,256), DEFAULT(0),
+       BLOCK_SIZE(1));
+
+
 bool
 Sys_var_slave_parallel_mode::global_update(THD *thd, set_var *var)
 {
@@ -2415,6 +2443,58 @@ Sys_binlog_commit_wait_usec(
        VALID_RANGE(0, ULONG_MAX), DEFAULT(100000), BLOCK_SIZE(1));
 
 
+static const char *binlog_transaction_dependency_tracking_names[]=
+  {"COMMIT_ORDER", "WRITESET", NullS};
+static Sys_var_on_access_global<Sys_var_enum,
+                   PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_TRANSACTION_DEPENDENCY>
+Sys_binlog_transaction_dependency_tracking(
+       "binlog_transaction_dependency_tracking",
+       "How the master decides which transactions may be applied in "
+       "parallel on a slave running in conservative parallel mode. "
+       "COMMIT_ORDER: only transactions that group committed together. "
+       "WRITESET: also consecutive row-based transactions that modify "
+       "disjoint sets of unique key values in transactional tables",
+       GLOBAL_VAR(opt_binlog_transaction_dependency_tracking),
+       CMD_LINE(REQUIRED_ARG), binlog_transaction_dependency_tracking_names,
+       DEFAULT(BINLOG_DEPENDENCY_TRACKING_COMMIT_ORDER));
+
+
+static Sys_var_on_access_global<Sys_var_ulong,
+                   PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_TRANSACTION_DEPENDENCY>
+Sys_binlog_transaction_dependency_history_size(
+       "binlog_transaction_dependency_history_size",
+       "Maximum number of unique key hashes remembered for the current "
+       "group of independent transactions when "
+       "binlog_transaction_dependency_tracking=WRITESET. A transaction that "
+       "modifies more rows than this is never applied in parallel with "
+       "others",
+       GLOBAL_VAR(opt_binlog_transaction_dependency_history_size),
+       CMD_LINE(REQUIRED_ARG), VALID_RANGE(1, 1000000), DEFAULT(25000),
+       BLOCK_SIZE(1));
+
+
+static Sys_var_on_access_global<Sys_var_mybool,
+                   PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_GTID_INDEX>
+Sys_binlog_gtid_index(
+       "binlog_gtid_index",
+       "Write a sparse index from GTID to binlog offset next to each binlog "
+       "file, in a file with the same name plus .idx. It is used by slaves "
+       "that connect with GTID, and by mysqlbinlog --gtid-index-seek, to "
+       "skip most of the binlog file before their start position. Takes "
+       "effect from the next binlog file",
+       GLOBAL_VAR(opt_binlog_gtid_index), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
+
+static Sys_var_on_access_global<Sys_var_ulong,
+                   PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_GTID_INDEX>
+Sys_binlog_gtid_index_span_min(
+       "binlog_gtid_index_span_min",
+       "Minimum number of bytes written to the binlog between two entries "
+       "of the GTID index, see binlog_gtid_index",
+       GLOBAL_VAR(opt_binlog_gtid_index_span_min), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, ULONG_MAX), DEFAULT(65536), BLOCK_SIZE(1));
+
+
 static bool fix_max_join_size(sys_var *self, THD *thd, enum_var_type type)
 {
   SV *sv= type == OPT_GLOBAL ? &global_system_variables : &thd->variables;
@@ -2467,6 +2547,13 @@ static Sys_var_ulong Sys_max_sort_length(
        SESSION_VAR(max_sort_length), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(64, 8192*1024L), DEFAULT(1024), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_max_sort_threads(
+       "max_sort_threads",
+       "The maximum number of threads that filesort may use for sorting "
+       "a buffer of keys. 1 disables parallel sorting",
+       SESSION_VAR(max_sort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, MAX_SORT_THREADS), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_max_sp_recursion_depth(
        "max_sp_recursion_depth",
        "Maximum stored procedure recursion depth",
@@ -2714,6 +2801,7 @@ export const char *optimizer_switch_names[]=
   "rowid_filter",
   "condition_pushdown_from_having",
   "not_null_range_scan",
+  "condition_prefilter",
   "default", 
   NullS
 };
@@ -3309,6 +3397,32 @@ Slave_type_conversions(
        slave_type_conversions_name,
        DEFAULT(0));
 
+static bool check_slave_rows_search_algorithms(sys_var *self, THD *thd,
+                                               set_var *var)
+{
+  /* Rows must be locatable when the table has no usable index */
+  return !(var->save_result.ulonglong_value &
+           ((1ULL << SLAVE_ROWS_TABLE_SCAN) | (1ULL << SLAVE_ROWS_HASH_SCAN)));
+}
+
+static const char *slave_rows_search_algorithms_names[]=
+  {"TABLE_SCAN", "INDEX_SCAN", "HASH_SCAN", 0};
+static Sys_var_on_access_global<Sys_var_set,
+                     PRIV_SET_SYSTEM_GLOBAL_VAR_SLAVE_ROWS_SEARCH_ALGORITHMS>
+Slave_rows_search_algorithms(
+       "slave_rows_search_algorithms",
+       "Set of algorithms the slave may use to find the rows of a row-based "
+       "UPDATE or DELETE event when the table has no primary or usable "
+       "unique key. INDEX_SCAN scans a non-unique index for each row. "
+       "HASH_SCAN matches all rows of an event in a single table scan. "
+       "TABLE_SCAN scans the table for each row, and is used when neither "
+       "of the others applies. Must include TABLE_SCAN or HASH_SCAN",
+       GLOBAL_VAR(slave_rows_search_algorithms_options), CMD_LINE(REQUIRED_ARG),
+       slave_rows_search_algorithms_names,
+       DEFAULT((1ULL << SLAVE_ROWS_TABLE_SCAN) | (1ULL << SLAVE_ROWS_INDEX_SCAN)),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG,
+       ON_CHECK(check_slave_rows_search_algorithms));
+
 static Sys_var_on_access_global<Sys_var_mybool,
                            PRIV_SET_SYSTEM_GLOBAL_VAR_SLAVE_SQL_VERIFY_CHECKSUM>
 Sys_slave_sql_verify_checksum(
@@ -3839,6 +3953,13 @@ static Sys_var_uint Sys_table_cache_instances(
        READ_ONLY GLOBAL_VAR(tc_instances), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(1, 64), DEFAULT(8), BLOCK_SIZE(1));
 
+static Sys_var_uint Sys_table_cache_thread_slots(
+       "table_open_cache_thread_slots",
+       "Number of recently used tables each connection keeps for reuse "
+       "without locking the table cache (0 disables it)",
+       READ_ONLY GLOBAL_VAR(tc_thread_slots), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, TC_THREAD_SLOTS_MAX), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_thread_cache_size(
        "thread_cache_size",
        "How many threads we should keep in a cache for reuse. These are freed after 5 minutes of idle time",
@@ -4005,6 +4126,16 @@ Sys_threadpool_dedicated_listener(
   GLOBAL_VAR(threadpool_dedicated_listener), CMD_LINE(OPT_ARG), DEFAULT(FALSE),
   NO_MUTEX_GUARD, NOT_IN_BINLOG
 );
+
+static Sys_var_on_access_global<Sys_var_mybool,
+                                PRIV_SET_SYSTEM_GLOBAL_VAR_THREAD_POOL>
+Sys_threadpool_work_stealing(
+  "thread_pool_work_stealing",
+  "If set to 1, idle worker threads take over queued connections from busy "
+  "thread groups",
+  GLOBAL_VAR(threadpool_work_stealing), CMD_LINE(OPT_ARG), DEFAULT(FALSE),
+  NO_MUTEX_GUARD, NOT_IN_BINLOG
+);
 #endif /* HAVE_POOL_OF_THREADS */
 
 /**
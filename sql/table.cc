@@ -5258,7 +5258,9 @@ bool TABLE_SHARE::visit_subgraph(Wait_for_flush *wait_for_flush,
 
   while ((table= tables_it++))
   {
-    DBUG_ASSERT(table->in_use && tdc->flushed);
+    DBUG_ASSERT(tdc->flushed);
+    if (!tc_table_in_use(table))
+      continue;
     if (gvisitor->inspect_edge(&table->in_use->mdl_context))
     {
       goto end_leave_node;
@@ -5268,7 +5270,9 @@ bool TABLE_SHARE::visit_subgraph(Wait_for_flush *wait_for_flush,
   tables_it.rewind();
   while ((table= tables_it++))
   {
-    DBUG_ASSERT(table->in_use && tdc->flushed);
+    DBUG_ASSERT(tdc->flushed);
+    if (!tc_table_in_use(table))
+      continue;
     if (table->in_use->mdl_context.visit_subgraph(gvisitor))
     {
       goto end_leave_node;
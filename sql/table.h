@@ -26,6 +26,7 @@
 #ifndef MYSQL_CLIENT
 
 #include "my_cpu.h"                             /* LF_BACKOFF() */
+#include "my_atomic_wrapper.h"                  /* Atomic_relaxed */
 #include "hash.h"                               /* HASH */
 #include "handler.h"                /* row_type, ha_choice, handler */
 #include "mysql_com.h"              /* enum_field_types */
@@ -1247,6 +1248,14 @@ struct TABLE
 public:
 
   uint32 instance; /** Table cache instance this TABLE is belonging to */
+  /**
+    Whether the object is parked in a slot of the thread that released it,
+    see tc_park_table(). Changed without locks by the owning thread, and
+    by evicting threads under TABLE_SHARE::tdc.LOCK_table_share or the
+    LOCK_table_cache of the instance.
+    Atomic_relaxed rather than std::atomic, so that TABLE stays copyable.
+  */
+  Atomic_relaxed<uint8> tc_state;
   THD	*in_use;                        /* Which thread uses this */
 
   uchar *record[3];			/* Pointer to records */
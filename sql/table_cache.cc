@@ -56,6 +56,7 @@
 ulong tdc_size; /**< Table definition cache threshold for LRU eviction. */
 ulong tc_size; /**< Table cache threshold for LRU eviction. */
 uint32 tc_instances;
+uint tc_thread_slots; /**< TABLE objects each thread keeps for reuse. */
 static std::atomic<uint32_t> tc_active_instances(1);
 static std::atomic<bool> tc_contention_warning_reported;
 
@@ -117,16 +118,24 @@ static int fix_thd_pins(THD *thd)
 
 struct Table_cache_instance
 {
+  typedef I_P_List <TABLE, I_P_List_adapter<TABLE, &TABLE::global_free_next,
+                                            &TABLE::global_free_prev>,
+                    I_P_List_null_counter, I_P_List_fast_push_back<TABLE> >
+    Table_list;
+
   /**
-    Protects free_tables (TABLE::global_free_next and TABLE::global_free_prev),
-    records, Share_free_tables::List (TABLE::prev and TABLE::next),
-    TABLE::in_use.
+    Protects free_tables and parked_tables (TABLE::global_free_next and
+    TABLE::global_free_prev), records, Share_free_tables::List (TABLE::prev
+    and TABLE::next), TABLE::in_use.
   */
   mysql_mutex_t LOCK_table_cache;
-  I_P_List <TABLE, I_P_List_adapter<TABLE, &TABLE::global_free_next,
-                                    &TABLE::global_free_prev>,
-            I_P_List_null_counter, I_P_List_fast_push_back<TABLE> >
-    free_tables;
+  Table_list free_tables;
+  /**
+    Objects that have been parked by a thread, see tc_park_table(). They
+    are never on free_tables at the same time, so they share its links.
+    Only the objects in TC_PARKED state can be evicted.
+  */
+  Table_list parked_tables;
   ulong records;
   uint mutex_waits;
   uint mutex_nowaits;
@@ -143,9 +152,18 @@ struct Table_cache_instance
   {
     mysql_mutex_destroy(&LOCK_table_cache);
     DBUG_ASSERT(free_tables.is_empty());
+    DBUG_ASSERT(parked_tables.is_empty());
     DBUG_ASSERT(records == 0);
   }
 
+  /**
+    Evict the least recently registered object that is parked by a thread
+    and is not being used by it.
+
+    @return the evicted object, which the caller must close, or NULL
+  */
+  TABLE *evict_parked_table();
+
   /**
     Lock table cache mutex and check contention.
 
@@ -213,12 +231,62 @@ struct Table_cache_instance
 static Table_cache_instance *tc;
 
 
+/**
+  States of TABLE::tc_state.
+
+  A TABLE object released by a thread may be parked in a slot of that
+  thread (THD::tc_thread_tables) instead of being returned to the free
+  lists of its table cache instance. The owner takes it back without
+  locking anything, while tc_remove_all_unused_tables() may evict it
+  concurrently. Whoever of the evicting thread and the owner comes last
+  frees the memory of an evicted object.
+*/
+enum tc_table_state
+{
+  TC_NOT_PARKED= 0,
+  /** In a thread slot, not used */
+  TC_PARKED,
+  /** Taken back from the thread slot and used by the thread */
+  TC_OWNED,
+  /** Taken by an evicting thread, still referenced by a thread slot */
+  TC_EVICTING,
+  /** Closed by the evicting thread, still referenced by a thread slot */
+  TC_CLOSED,
+  /** Dropped from the thread slot, the evicting thread frees it */
+  TC_ORPHANED
+};
+
+
+TABLE *Table_cache_instance::evict_parked_table()
+{
+  mysql_mutex_assert_owner(&LOCK_table_cache);
+  Table_list::Iterator it(parked_tables);
+  while (auto table= it++)
+  {
+    uint8 state= TC_PARKED;
+    if (table->tc_state.compare_exchange_strong(state, TC_EVICTING,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_relaxed))
+    {
+      parked_tables.remove(table);
+      return table;
+    }
+  }
+  return NULL;
+}
+
+
 static void intern_close_table(TABLE *table)
 {
   delete table->triggers;
   DBUG_ASSERT(table->file);
   closefrm(table);
   tdc_release_share(table->s);
+  /* An evicted parked object may still be referenced by its thread. */
+  if (table->tc_state == TC_EVICTING &&
+      table->tc_state.exchange(TC_CLOSED, std::memory_order_acq_rel) !=
+      TC_ORPHANED)
+    return;
   my_free(table);
 }
 
@@ -275,6 +343,35 @@ static void tc_remove_all_unused_tables(TDC_element *element,
     }
     mysql_mutex_unlock(&tc[i].LOCK_table_cache);
   }
+
+  if (!tc_thread_slots)
+    return;
+
+  /*
+    Evict objects parked by threads. Pairs with the fence in
+    tc_park_table(): either the parking thread sees TDC_element::flushed
+    set by our caller, or we see TC_PARKED.
+  */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  All_share_tables_list::Iterator it(element->all_tables);
+  while (auto table= it++)
+  {
+    uint8 state= TC_PARKED;
+    if (table->tc_state != TC_PARKED ||
+        !table->tc_state.compare_exchange_strong(state, TC_EVICTING,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_relaxed))
+      continue;
+    mysql_mutex_lock(&tc[table->instance].LOCK_table_cache);
+    tc[table->instance].records--;
+    tc[table->instance].parked_tables.remove(table);
+    mysql_mutex_unlock(&tc[table->instance].LOCK_table_cache);
+    DBUG_ASSERT(element->all_tables_refs == 0);
+    element->all_tables.remove(table);
+    /* Parked objects keep TABLE::in_use of their thread, see tc_park_table() */
+    table->in_use= 0;
+    purge_tables->push_front(table);
+  }
 }
 
 
@@ -357,6 +454,16 @@ void tc_add_table(THD *thd, TABLE *table)
       /* Keep out of locked LOCK_table_cache */
       tc_remove_table(LRU_table);
     }
+    else if ((LRU_table= tc[i].evict_parked_table()))
+    {
+      /*
+        No free object left: evict one that a thread has parked, so that
+        parking does not make the cache exceed table_open_cache.
+      */
+      LRU_table->in_use= thd;
+      mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+      tc_remove_table(LRU_table);
+    }
     else
     {
       tc[i].records++;
@@ -407,7 +514,7 @@ TABLE *tc_acquire_table(THD *thd, TDC_element *element)
 
 
 /**
-  Release TABLE object to table cache.
+  Release TABLE object to its table cache instance.
 
   @pre object is used by caller.
 
@@ -432,15 +539,21 @@ TABLE *tc_acquire_table(THD *thd, TDC_element *element)
     @retval false object released
 */
 
-void tc_release_table(TABLE *table)
+static void tc_release_table_to_instance(TABLE *table)
 {
   uint32 i= table->instance;
-  DBUG_ENTER("tc_release_table");
+  DBUG_ENTER("tc_release_table_to_instance");
   DBUG_ASSERT(table->in_use);
   DBUG_ASSERT(table->file);
   DBUG_ASSERT(!table->pos_in_locked_tables);
 
   mysql_mutex_lock(&tc[i].LOCK_table_cache);
+  if (table->tc_state == TC_OWNED)
+  {
+    /* The object was parked before; it is not parked anymore. */
+    tc[i].parked_tables.remove(table);
+    table->tc_state= TC_NOT_PARKED;
+  }
   if (table->needs_reopen() || table->s->tdc->flushed ||
       tc[i].records > tc_size)
   {
@@ -459,6 +572,190 @@ void tc_release_table(TABLE *table)
 }
 
 
+/**
+  Take a parked TABLE object back from the evicting threads.
+
+  @return
+    @retval true  the caller owns the object
+    @retval false the object was evicted and must not be accessed anymore
+*/
+
+static bool tc_unpark_table(TABLE *table)
+{
+  uint8 state= TC_PARKED;
+  if (table->tc_state.compare_exchange_strong(state, TC_OWNED,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire))
+    return true;
+  DBUG_ASSERT(state == TC_EVICTING || state == TC_CLOSED);
+  if (table->tc_state.exchange(TC_ORPHANED, std::memory_order_acq_rel) ==
+      TC_CLOSED)
+    my_free(table);
+  return false;
+}
+
+
+/**
+  Park a released TABLE object in a slot of the thread that used it.
+
+  The object stays in TABLE_SHARE::tdc.all_tables and is still counted by
+  its table cache instance, but it is not put on the free lists, so the
+  thread can take it back without locking the instance. Only when an
+  object is parked for the first time, it is registered in
+  Table_cache_instance::parked_tables, where tc_add_table() finds it if
+  the instance is full. tc_remove_all_unused_tables() evicts parked
+  objects as well.
+
+  @return
+    @retval true  object parked
+    @retval false object must be released to its table cache instance
+*/
+
+static bool tc_park_table(TABLE *table)
+{
+  THD *thd= table->in_use;
+  TDC_element *element= table->s->tdc;
+  uint slot;
+
+  if (table->needs_reopen() || element->flushed)
+    return false;
+
+  for (slot= 0; slot < tc_thread_slots; slot++)
+    if (!thd->tc_thread_tables[slot])
+      break;
+  if (slot == tc_thread_slots)
+  {
+    /* All slots are taken: release the object in the next one. */
+    slot= thd->tc_thread_next_slot;
+    thd->tc_thread_next_slot= (slot + 1) % tc_thread_slots;
+    TABLE *old= thd->tc_thread_tables[slot];
+    thd->tc_thread_tables[slot]= 0;
+    if (tc_unpark_table(old))
+      tc_release_table_to_instance(old);
+  }
+
+  if (table->tc_state == TC_NOT_PARKED)
+  {
+    mysql_mutex_lock(&tc[table->instance].LOCK_table_cache);
+    tc[table->instance].parked_tables.push_back(table);
+    mysql_mutex_unlock(&tc[table->instance].LOCK_table_cache);
+  }
+
+  thd->tc_thread_tables[slot]= table;
+  thd->tc_thread_hash_values[slot]=
+    my_hash_sort(&my_charset_bin, (const uchar*) element->m_key,
+                 element->m_key_length) & INT_MAX32;
+  /*
+    TABLE::in_use stays set: the object remains in TDC_element::all_tables,
+    where the MDL deadlock detector must never find in_use == 0. It skips
+    parked objects instead, see tc_table_in_use().
+  */
+  /* Publish the object to evicting threads, which acquire it by CAS. */
+  std::atomic_thread_fence(std::memory_order_release);
+  table->tc_state= TC_PARKED;
+
+  /*
+    FLUSH TABLES marks the share flushed and then evicts unused objects
+    without a metadata lock. Pairs with the fence in
+    tc_remove_all_unused_tables(). If the object was evicted meanwhile,
+    the share may be gone and the value read is meaningless, but then
+    tc_unpark_table() fails anyway.
+  */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (unlikely(element->flushed))
+  {
+    thd->tc_thread_tables[slot]= 0;
+    return !tc_unpark_table(table);
+  }
+  return true;
+}
+
+
+/**
+  Take a TABLE object parked by this thread, see tc_park_table().
+
+  @return TABLE object, or NULL if the thread has no object for the key.
+*/
+
+static TABLE *tc_acquire_thread_table(THD *thd, my_hash_value_type hash_value,
+                                      const char *key, uint key_length)
+{
+  hash_value&= INT_MAX32;
+  for (uint slot= 0; slot < tc_thread_slots; slot++)
+  {
+    TABLE *table= thd->tc_thread_tables[slot];
+    if (!table || thd->tc_thread_hash_values[slot] != hash_value)
+      continue;
+    thd->tc_thread_tables[slot]= 0;
+    if (!tc_unpark_table(table))
+      continue;
+    DBUG_ASSERT(table->in_use == thd);
+    if (table->s->table_cache_key.length != key_length ||
+        memcmp(table->s->table_cache_key.str, key, key_length))
+    {
+      /* Hash collision */
+      tc_release_table_to_instance(table);
+      continue;
+    }
+    /* The ex-unused table must be fully functional. */
+    DBUG_ASSERT(table->db_stat && table->file);
+    /* The children must be detached from the table. */
+    DBUG_ASSERT(!table->file->extra(HA_EXTRA_IS_ATTACHED_CHILDREN));
+    return table;
+  }
+  return NULL;
+}
+
+
+/**
+  Release TABLE object to table cache.
+
+  If table_open_cache_thread_slots is set, the object is parked in a slot
+  of the thread that used it, see tc_park_table(). Otherwise, or if it
+  cannot be parked, it is returned to its table cache instance.
+*/
+
+void tc_release_table(TABLE *table)
+{
+  DBUG_ENTER("tc_release_table");
+  DBUG_ASSERT(table->in_use);
+  if (!tc_thread_slots || !tc_park_table(table))
+    tc_release_table_to_instance(table);
+  DBUG_VOID_RETURN;
+}
+
+
+/**
+  Release all TABLE objects parked by a thread that is going away.
+*/
+
+void tc_release_thread_tables(THD *thd)
+{
+  for (uint slot= 0; slot < tc_thread_slots; slot++)
+  {
+    TABLE *table= thd->tc_thread_tables[slot];
+    if (!table)
+      continue;
+    thd->tc_thread_tables[slot]= 0;
+    if (tc_unpark_table(table))
+      tc_release_table_to_instance(table);
+  }
+}
+
+
+/**
+  Check if a TABLE object in TABLE_SHARE::tdc.all_tables is used by a thread.
+
+  Objects parked by a thread keep TABLE::in_use pointing to it, but they
+  are not used, so the MDL deadlock detector must not follow them.
+*/
+
+bool tc_table_in_use(const TABLE *table)
+{
+  return table->in_use && table->tc_state != TC_PARKED;
+}
+
+
 static void tdc_assert_clean_share(TDC_element *element)
 {
   DBUG_ASSERT(element->share == 0);
@@ -801,6 +1098,14 @@ TABLE_SHARE *tdc_acquire_share(THD *thd, TABLE_LIST *tl, uint flags,
   bool was_unused;
   DBUG_ENTER("tdc_acquire_share");
 
+  if (tc_thread_slots && out_table && (flags & GTS_TABLE) &&
+      (*out_table= tc_acquire_thread_table(thd, hash_value, key, key_length)))
+  {
+    DBUG_ASSERT(!(flags & GTS_NOLOCK));
+    status_var_increment(thd->status_var.table_open_cache_hits);
+    DBUG_RETURN((*out_table)->s);
+  }
+
   if (fix_thd_pins(thd))
     DBUG_RETURN(0);
 
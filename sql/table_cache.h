@@ -64,6 +64,7 @@ struct TDC_element
 extern ulong tdc_size;
 extern ulong tc_size;
 extern uint32 tc_instances;
+extern uint tc_thread_slots;
 
 extern bool tdc_init(void);
 extern void tdc_start_shutdown(void);
@@ -92,6 +93,8 @@ int show_tc_active_instances(THD *thd, SHOW_VAR *var, char *buff,
 extern void tc_purge();
 extern void tc_add_table(THD *thd, TABLE *table);
 extern void tc_release_table(TABLE *table);
+extern void tc_release_thread_tables(THD *thd);
+extern bool tc_table_in_use(const TABLE *table);
 extern TABLE *tc_acquire_table(THD *thd, TDC_element *element);
 
 /**
@@ -1147,6 +1147,53 @@ static bool too_many_threads(thread_group_t *thread_group)
 }
 
 
+/**
+  Take over a queued connection from another, busy, thread group.
+
+  Called by a worker that found nothing to do in its own group, without
+  holding its group mutex. A group is considered busy if it has queued
+  connections but no waiting worker threads that could pick them up.
+
+  The connection is migrated to the stealing group, i.e it is removed from
+  the poll descriptor of its old group and will be associated with the
+  new group's poll descriptor in the next start_io(). This way, connections
+  move away from overloaded groups over time.
+
+  @param thread_group - group of the current worker
+
+  @return connection taken over, or NULL
+*/
+
+static TP_connection_generic *steal_connection(thread_group_t *thread_group)
+{
+  TP_connection_generic *connection= NULL;
+  uint n_groups= group_count;
+  uint self= (uint) (thread_group - all_groups);
+
+  for (uint i= 1; i < n_groups && !connection; i++)
+  {
+    thread_group_t *group= &all_groups[(self + i) % n_groups];
+
+    /* Busy groups are skipped rather than waited for. */
+    if (mysql_mutex_trylock(&group->mutex))
+      continue;
+
+    if (!group->shutdown && group->waiting_threads.is_empty() &&
+        (connection= queue_get(group, operation_origin::WORKER)))
+    {
+      if (connection->bound_to_poll_descriptor)
+      {
+        io_poll_disassociate_fd(group->pollfd, connection->fd);
+        connection->bound_to_poll_descriptor= false;
+      }
+      group->connection_count--;
+    }
+    mysql_mutex_unlock(&group->mutex);
+  }
+  return connection;
+}
+
+
 /**
   Retrieve a connection with pending event.
 
@@ -1170,6 +1217,7 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
 {
   DBUG_ENTER("get_event");
   TP_connection_generic *connection = NULL;
+  bool tried_stealing= false;
 
 
   mysql_mutex_lock(&thread_group->mutex);
@@ -1228,6 +1276,27 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
     }
 
 
+    /*
+      Before going to sleep, take over queued work from a busy group.
+      The group mutex is released meanwhile, so recheck our own queue
+      afterwards.
+    */
+    if (threadpool_work_stealing && !oversubscribed && !tried_stealing &&
+        group_count > 1)
+    {
+      tried_stealing= true;
+      mysql_mutex_unlock(&thread_group->mutex);
+      connection= steal_connection(thread_group);
+      mysql_mutex_lock(&thread_group->mutex);
+      if (connection)
+      {
+        connection->thread_group= thread_group;
+        thread_group->connection_count++;
+        break;
+      }
+      continue;
+    }
+
     /* And now, finally sleep */
     current_thread->woken = false; /* wake() sets this to true */
 
@@ -1262,6 +1331,7 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
 
     if (err)
       break;
+    tried_stealing= false;
   }
 
   thread_group->stalled= false;
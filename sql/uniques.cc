@@ -77,9 +77,13 @@ int unique_intersect_write_to_ptrs(uchar* key, element_count count, Unique *uniq
 }
 
 
+/* Initial number of elements of the hash table, see Unique::hash_insert() */
+static const ulong UNIQUE_HASH_MIN_CAPACITY= 64;
+
+
 Unique::Unique(qsort_cmp2 comp_func, void * comp_func_fixed_arg,
 	       uint size_arg, size_t max_in_memory_size_arg,
-               uint min_dupl_count_arg)
+               uint min_dupl_count_arg, bool use_hash_arg)
   :max_in_memory_size(max_in_memory_size_arg),
    size(size_arg),
    elements(0)
@@ -90,6 +94,14 @@ Unique::Unique(qsort_cmp2 comp_func, void * comp_func_fixed_arg,
   if (min_dupl_count_arg)
     full_size+= sizeof(element_count);
   with_counters= MY_TEST(min_dupl_count_arg);
+  /*
+    The hash table does not count duplicates, and it needs a non-empty key:
+    COUNT(DISTINCT) over a BINARY(0) column has size == 0.
+  */
+  use_hash= use_hash_arg && !with_counters && size;
+  hash_keys= NULL;
+  hash_slots= NULL;
+  hash_capacity= hash_elements= hash_mask= 0;
   init_tree(&tree, (max_in_memory_size / 16), 0, size, comp_func,
             NULL, comp_func_fixed_arg, MYF(MY_THREAD_SPECIFIC));
   /* If the following fail's the next add will also fail */
@@ -100,6 +112,23 @@ Unique::Unique(qsort_cmp2 comp_func, void * comp_func_fixed_arg,
   */
   max_elements= (ulong) (max_in_memory_size /
                          ALIGN_SIZE(sizeof(TREE_ELEMENT)+size));
+  if (use_hash)
+  {
+    /*
+      The table is at most half full, and hash_resize() rounds the number
+      of slots up to a power of two. Choose the capacity that fits into
+      max_in_memory_size together with its rounded up slots.
+    */
+    max_elements= 0;
+    for (size_t n_slots= 2; n_slots <= UINT_MAX32 / 2 &&
+           n_slots * sizeof(uint32) < max_in_memory_size; n_slots<<= 1)
+    {
+      ulong capacity= (ulong) MY_MIN(n_slots / 2,
+                                     (max_in_memory_size -
+                                      n_slots * sizeof(uint32)) / size);
+      set_if_bigger(max_elements, capacity);
+    }
+  }
   if (!max_elements)
     max_elements= 1;
 
@@ -371,6 +400,112 @@ Unique::~Unique()
   close_cached_file(&file);
   delete_tree(&tree, 0);
   delete_dynamic(&file_ptrs);
+  my_free(hash_keys);
+  my_free(hash_slots);
+}
+
+
+/*
+  Put all elements of the hash table into the slots, which must be
+  allocated and be at least twice as many as the elements.
+*/
+
+void Unique::hash_rebuild()
+{
+  bzero(hash_slots, (hash_mask + 1) * sizeof *hash_slots);
+  for (ulong n= 0; n < hash_elements; n++)
+  {
+    ulong i= my_crc32c(0, hash_keys + n * size, size) & hash_mask;
+    while (hash_slots[i])
+      i= (i + 1) & hash_mask;
+    hash_slots[i]= (uint32) (n + 1);
+  }
+}
+
+
+/*
+  Make room for capacity elements in the hash table. For any capacity up
+  to max_elements, the keys and the slots fit into max_in_memory_size.
+*/
+
+bool Unique::hash_resize(ulong capacity)
+{
+  ulong n_slots= 1;
+  while (n_slots < 2 * capacity)
+    n_slots<<= 1;
+  uchar *keys= (uchar*) my_realloc(PSI_INSTRUMENT_ME, hash_keys,
+                                   MY_MAX(capacity * size, 1),
+                                   MYF(MY_THREAD_SPECIFIC | MY_WME |
+                                       MY_ALLOW_ZERO_PTR));
+  if (!keys)
+    return 1;
+  hash_keys= keys;
+  my_free(hash_slots);
+  if (!(hash_slots= (uint32*) my_malloc(PSI_INSTRUMENT_ME,
+                                        n_slots * sizeof *hash_slots,
+                                        MYF(MY_THREAD_SPECIFIC | MY_WME))))
+  {
+    hash_capacity= hash_elements= 0;
+    return 1;
+  }
+  hash_capacity= capacity;
+  hash_mask= n_slots - 1;
+  hash_rebuild();
+  return 0;
+}
+
+
+/*
+  Add an element to the hash table unless it is already there. The table
+  starts small and doubles as needed up to max_elements; it is never more
+  than half full, so linear probing stays short.
+*/
+
+bool Unique::hash_insert(const uchar *key)
+{
+  if (hash_elements == hash_capacity &&
+      hash_resize(MY_MIN(MY_MAX(hash_capacity * 2, UNIQUE_HASH_MIN_CAPACITY),
+                         max_elements)))
+    return 1;
+  DBUG_ASSERT(hash_elements < hash_capacity);
+
+  for (ulong i= my_crc32c(0, key, size) & hash_mask;; i= (i + 1) & hash_mask)
+  {
+    uint32 slot= hash_slots[i];
+    if (!slot)
+    {
+      memcpy(hash_keys + hash_elements * size, key, size);
+      hash_slots[i]= (uint32) ++hash_elements;
+      return 0;
+    }
+    if (!memcmp(hash_keys + (slot - 1) * size, key, size))
+      return 0;
+  }
+}
+
+
+/*
+  Sort the elements of the hash table in the order of the tree compare
+  function, so that they can be written or walked like a tree.
+*/
+
+void Unique::hash_sort()
+{
+  if (hash_elements < 2)
+    return;
+  my_qsort2(hash_keys, hash_elements, size, (qsort2_cmp) tree.compare,
+            tree.custom_arg);
+  hash_rebuild();
+}
+
+
+bool Unique::hash_walk(tree_walk_action action, void *walk_action_arg)
+{
+  hash_sort();
+  for (ulong n= 0; n < hash_elements; n++)
+    if (action(hash_keys + n * size, 1, walk_action_arg))
+      return 1;
+  return 0;
 }
 
 
@@ -378,10 +513,21 @@ Unique::~Unique()
 bool Unique::flush()
 {
   Merge_chunk file_ptr;
-  elements+= tree.elements_in_tree;
-  file_ptr.set_rowcount(tree.elements_in_tree);
+  elements+= elements_in_tree();
+  file_ptr.set_rowcount(elements_in_tree());
   file_ptr.set_file_position(my_b_tell(&file));
 
+  if (use_hash)
+  {
+    hash_sort();
+    if (my_b_write(&file, hash_keys, hash_elements * size) ||
+        insert_dynamic(&file_ptrs, (uchar*) &file_ptr))
+      return 1;
+    hash_elements= 0;
+    bzero(hash_slots, (hash_mask + 1) * sizeof *hash_slots);
+    return 0;
+  }
+
   tree_walk_action action= min_dupl_count ?
 		           (tree_walk_action) unique_write_to_file_with_count :
 		           (tree_walk_action) unique_write_to_file;
@@ -403,6 +549,18 @@ void
 Unique::reset()
 {
   reset_tree(&tree);
+  if (hash_capacity > UNIQUE_HASH_MIN_CAPACITY)
+  {
+    /* Do not keep a large table around for e.g. the next GROUP BY group */
+    my_free(hash_keys);
+    my_free(hash_slots);
+    hash_keys= NULL;
+    hash_slots= NULL;
+    hash_capacity= 0;
+  }
+  else if (hash_slots)
+    bzero(hash_slots, (hash_mask + 1) * sizeof *hash_slots);
+  hash_elements= 0;
   /*
     If elements != 0, some trees were stored in the file (see how
     flush() works). Note, that we can not count on my_b_tell(&file) == 0
@@ -651,9 +809,10 @@ bool Unique::walk(TABLE *table, tree_walk_action action, void *walk_action_arg)
   uchar *merge_buffer;
 
   if (elements == 0)                       /* the whole tree is in memory */
-    return tree_walk(&tree, action, walk_action_arg, left_root_right);
+    return use_hash ? hash_walk(action, walk_action_arg) :
+      tree_walk(&tree, action, walk_action_arg, left_root_right);
 
-  sort.return_rows= elements+tree.elements_in_tree;
+  sort.return_rows= elements+elements_in_tree();
   /* flush current tree to the file to have some memory for merge buffer */
   if (flush())
     return 1;
@@ -786,7 +945,7 @@ bool Unique::get(TABLE *table)
 {
   bool rc= 1;
   uchar *sort_buffer= NULL;
-  sort.return_rows= elements+tree.elements_in_tree;
+  sort.return_rows= elements+elements_in_tree();
   DBUG_ENTER("Unique::get");
 
   if (my_b_tell(&file) == 0)
@@ -794,8 +953,14 @@ bool Unique::get(TABLE *table)
     /* Whole tree is in memory;  Don't use disk if you don't need to */
     if ((sort.record_pointers= (uchar*)
 	 my_malloc(key_memory_Filesort_info_record_pointers,
-                   size * tree.elements_in_tree, MYF(MY_THREAD_SPECIFIC))))
+                   size * elements_in_tree(), MYF(MY_THREAD_SPECIFIC))))
     {
+      if (use_hash)
+      {
+        hash_sort();
+        memcpy(sort.record_pointers, hash_keys, size * hash_elements);
+        DBUG_RETURN(0);
+      }
       uchar *save_record_pointers= sort.record_pointers;
       tree_walk_action action= min_dupl_count ?
 		         (tree_walk_action) unique_intersect_write_to_ptrs :
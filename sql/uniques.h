@@ -24,6 +24,12 @@
    it's dumped to the file. User can request sorted values, or
    just iterate through them. In the last case tree merging is performed in
    memory simultaneously with iteration, so it should be ~2-3x faster.
+
+   If the elements compare bytewise (the compare function is memcmp()
+   equivalent), the caller may ask for an open addressing hash table
+   instead of the TREE. Elements are then kept in a contiguous array with
+   a 4-byte slot per element, and they are only sorted when the array is
+   dumped to the file or when the caller needs them.
  */
 
 class Unique :public Sql_alloc
@@ -45,6 +51,20 @@ class Unique :public Sql_alloc
                             always 0 for unions, > 0 for intersections */
   bool with_counters;
 
+  /* Hash table used instead of the tree, see the class comment */
+  bool use_hash;
+  uchar *hash_keys;     /* hash_elements elements of size bytes */
+  uint32 *hash_slots;   /* 0 for empty, otherwise element number + 1 */
+  ulong hash_capacity;  /* elements that fit into hash_keys */
+  ulong hash_elements;
+  ulong hash_mask;      /* number of slots - 1 */
+
+  bool hash_resize(ulong capacity);
+  void hash_rebuild();
+  bool hash_insert(const uchar *key);
+  void hash_sort();
+  bool hash_walk(tree_walk_action action, void *walk_action_arg);
+
   bool merge(TABLE *table, uchar *buff, size_t size, bool without_last_merge);
   bool flush();
 
@@ -53,16 +73,19 @@ class Unique :public Sql_alloc
   SORT_INFO sort;
   Unique(qsort_cmp2 comp_func, void *comp_func_fixed_arg,
 	 uint size_arg, size_t max_in_memory_size_arg,
-         uint min_dupl_count_arg= 0);
+         uint min_dupl_count_arg= 0, bool use_hash_arg= false);
   ~Unique();
-  ulong elements_in_tree() { return tree.elements_in_tree; }
+  ulong elements_in_tree()
+  { return use_hash ? hash_elements : tree.elements_in_tree; }
   inline bool unique_add(void *ptr)
   {
     DBUG_ENTER("unique_add");
-    DBUG_PRINT("info", ("tree %u - %lu", tree.elements_in_tree, max_elements));
+    DBUG_PRINT("info", ("tree %lu - %lu", elements_in_tree(), max_elements));
     if (!(tree.flag & TREE_ONLY_DUPS) && 
-        tree.elements_in_tree >= max_elements && flush())
+        elements_in_tree() >= max_elements && flush())
       DBUG_RETURN(1);
+    if (use_hash)
+      DBUG_RETURN(hash_insert((uchar*) ptr));
     DBUG_RETURN(!tree_insert(&tree, ptr, 0, tree.custom_arg));
   }
 
@@ -890,11 +890,46 @@ btr_search_check_guess(
 	return(success);
 }
 
+/** Account for the outcome of a hash search, and suppress the
+adaptive hash index for the index if most searches are failing,
+as is typical for scan-heavy or randomly modified tables.
+@param[in,out]	info	index search info
+@param[in]	success	whether the hash search succeeded */
+static void btr_search_sample(btr_search_t* info, bool success)
+{
+	ulint n_succ = info->n_sample_succ;
+	ulint n_fail = info->n_sample_fail;
+
+	if (success) {
+		info->n_sample_succ = ++n_succ;
+	} else {
+		info->n_sample_fail = ++n_fail;
+	}
+
+	if (n_succ + n_fail < BTR_SEARCH_SAMPLE_SIZE) {
+		return;
+	}
+
+	info->n_sample_succ = 0;
+	info->n_sample_fail = 0;
+
+	if (n_fail > n_succ) {
+		/* Stop trying hash searches. Any existing hash index
+		entries will be dropped when the pages are modified or
+		evicted, and btr_search_info_update() will resume the
+		analysis after BTR_SEARCH_SUPPRESS_SEARCHES searches. */
+		info->last_hash_succ = FALSE;
+		info->n_hash_potential = 0;
+		info->suppressed = BTR_SEARCH_SUPPRESS_SEARCHES;
+	}
+}
+
 static
 void
 btr_search_failure(btr_search_t* info, btr_cur_t* cursor)
 {
 	cursor->flag = BTR_CUR_HASH_FAIL;
+	btr_search_sample(info, false);
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	++info->n_hash_fail;
@@ -1219,6 +1254,7 @@ btr_search_guess_on_hash(
 	meanwhile! Thus it might not be a bug. */
 #endif
 	info->last_hash_succ = TRUE;
+	btr_search_sample(info, true);
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	btr_search_n_succ++;
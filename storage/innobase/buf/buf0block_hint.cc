@@ -33,7 +33,8 @@ void Block_hint::buffer_fix_block_if_still_valid()
   /* To check if m_block belongs to the current buf_pool, we must
   prevent freeing memory while we check, and until we buffer-fix the
   block. For this purpose it is enough to latch any of the many
-  latches taken by buf_pool_t::resize().
+  latches taken by buf_pool_t::resize(). buf_pool_t::fix_guess()
+  instead makes buf_pool_t::resize() wait for it.
 
   Similar to buf_page_optimistic_get(), we must validate
   m_block->page.id() after acquiring the hash_lock, because the object
@@ -46,6 +47,12 @@ void Block_hint::buffer_fix_block_if_still_valid()
   validate m_block->state() to ensure that the block is not being freed. */
   if (m_block)
   {
+    if (buf_pool.fix_guess(m_block, m_page_id))
+    {
+      ut_ad(fsp_is_system_temporary(m_page_id.space()) ||
+            rw_lock_s_lock_nowait(m_block->debug_latch, __FILE__, __LINE__));
+      return;
+    }
     const ulint fold= m_page_id.fold();
     page_hash_latch *hash_lock= buf_pool.page_hash.lock<false>(fold);
     if (buf_pool.is_uncompressed(m_block) && m_page_id == m_block->page.id() &&
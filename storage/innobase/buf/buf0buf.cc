@@ -1481,6 +1481,7 @@ bool buf_pool_t::create()
   srv_buf_pool_base_size= srv_buf_pool_size;
 
   last_activity_count= srv_get_activity_count();
+  page_cleaner_LRU_pending= false;
 
   chunk_t::map_ref= chunk_t::map_reg;
   buf_LRU_old_ratio_update(100 * 3 / 8, false);
@@ -2092,7 +2093,8 @@ inline void buf_pool_t::resize()
 	}
 
 	/* Indicate critical path */
-	resizing.store(true, std::memory_order_relaxed);
+	resizing.store(true);
+	wait_for_guesses();
 
   mysql_mutex_lock(&mutex);
   write_lock_all_page_hash();
@@ -2951,9 +2953,15 @@ buf_page_get_low(
 	buf_pool.stat.n_page_gets++;
 loop:
 	buf_block_t* fix_block;
+	page_hash_latch* hash_lock;
 	block = guess;
 
-	page_hash_latch* hash_lock = buf_pool.page_hash.lock<false>(fold);
+	if (block && buf_pool.fix_guess(block, page_id)) {
+		fix_block = block;
+		goto got_block;
+	}
+
+	hash_lock = buf_pool.page_hash.lock<false>(fold);
 
 	if (block) {
 
@@ -3977,6 +3985,9 @@ ATTRIBUTE_COLD void buf_pool_t::corrupted_evict(buf_page_t *bpage)
 
   ut_d(auto n=) n_pend_reads--;
   ut_ad(n > 0);
+
+  if (recv_recovery_is_on())
+    os_event_set(recv_sys.read_done);
 }
 
 /** Mark a table corrupted.
@@ -4246,6 +4257,9 @@ dberr_t buf_page_read_complete(buf_page_t *bpage, const fil_node_t &node)
   ut_ad(n > 0);
   buf_pool.stat.n_pages_read++;
 
+  if (recv_recovery_is_on())
+    os_event_set(recv_sys.read_done);
+
   return DB_SUCCESS;
 }
 
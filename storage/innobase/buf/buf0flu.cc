@@ -50,6 +50,10 @@ Created 11/11/1995 Heikki Tuuri
 Also included in buf_flush_page_count. */
 ulint buf_lru_flush_page_count;
 
+/** Number of times the page cleaner was woken up to replenish
+buf_pool.free. Protected by buf_pool.flush_list_mutex. */
+ulint buf_lru_wakeup_count;
+
 /** Number of pages flushed. Protected by buf_pool.mutex. */
 ulint buf_flush_page_count;
 
@@ -162,17 +166,40 @@ inline void buf_pool_t::page_cleaner_wakeup()
   }
 }
 
+/** Wake up the page cleaner to replenish the free list, so that
+buf_LRU_get_free_block() will not have to evict or flush pages itself. */
+void buf_pool_t::page_cleaner_wakeup_LRU()
+{
+  mysql_mutex_assert_owner(&mutex);
+  /* Signal at most once per LRU batch of the page cleaner, so that block
+  allocations do not contend on flush_list_mutex while buf_pool.free is
+  short. */
+  if (!buf_page_cleaner_is_active || page_cleaner_LRU_pending)
+    return;
+  /* Acquire flush_list_mutex so that the signal cannot be lost between
+  the check of page_cleaner_LRU_pending and the wait in
+  buf_flush_page_cleaner(). We do not clear page_cleaner_is_idle, so that
+  the flush_list heuristics are not affected. */
+  mysql_mutex_lock(&flush_list_mutex);
+  page_cleaner_LRU_pending= true;
+  buf_lru_wakeup_count++;
+  pthread_cond_signal(&do_flush_list);
+  mysql_mutex_unlock(&flush_list_mutex);
+}
+
 /** Insert a modified block into the flush list.
+The caller must hold buf_pool.flush_list_mutex and must invoke
+buf_flush_insert_wakeup() before releasing it.
 @param[in,out]	block	modified block
 @param[in]	lsn	oldest modification */
-void buf_flush_insert_into_flush_list(buf_block_t* block, lsn_t lsn)
+void buf_flush_insert_into_flush_list_low(buf_block_t* block, lsn_t lsn)
 {
 	mysql_mutex_assert_not_owner(&buf_pool.mutex);
 	mysql_mutex_assert_owner(&log_sys.flush_order_mutex);
+	mysql_mutex_assert_owner(&buf_pool.flush_list_mutex);
 	ut_ad(lsn);
 	ut_ad(!fsp_is_system_temporary(block->page.id().space()));
 
-	mysql_mutex_lock(&buf_pool.flush_list_mutex);
 	block->page.set_oldest_modification(lsn);
 	MEM_CHECK_DEFINED(block->page.zip.data
 			  ? block->page.zip.data : block->frame,
@@ -182,10 +209,27 @@ void buf_flush_insert_into_flush_list(buf_block_t* block, lsn_t lsn)
 
 	UT_LIST_ADD_FIRST(buf_pool.flush_list, &block->page);
 	ut_d(buf_flush_validate_skip());
+}
+
+/** Insert a modified block into the flush list.
+@param[in,out]	block	modified block
+@param[in]	lsn	oldest modification */
+void buf_flush_insert_into_flush_list(buf_block_t* block, lsn_t lsn)
+{
+	mysql_mutex_lock(&buf_pool.flush_list_mutex);
+	buf_flush_insert_into_flush_list_low(block, lsn);
 	buf_pool.page_cleaner_wakeup();
 	mysql_mutex_unlock(&buf_pool.flush_list_mutex);
 }
 
+/** Wake up the page cleaner if needed, after
+buf_flush_insert_into_flush_list_low() was invoked. */
+void buf_flush_insert_wakeup()
+{
+	mysql_mutex_assert_owner(&buf_pool.flush_list_mutex);
+	buf_pool.page_cleaner_wakeup();
+}
+
 /** Remove a block from buf_pool.flush_list */
 static void buf_flush_remove_low(buf_page_t *bpage)
 {
@@ -2120,10 +2164,13 @@ static os_thread_ret_t DECLARE_THREAD(buf_flush_page_cleaner)(void*)
 
     /* If buf pager cleaner is idle and there is no work
     (either dirty pages are all flushed or adaptive flushing
-    is not enabled) then opt for non-timed wait */
-    if (buf_pool.page_cleaner_idle() &&
-        (!UT_LIST_GET_LEN(buf_pool.flush_list) ||
-         srv_max_dirty_pages_pct_lwm == 0.0))
+    is not enabled, and buf_pool.free is not running short)
+    then opt for non-timed wait. Do not wait at all if
+    buf_LRU_get_free_block() requested an LRU batch meanwhile. */
+    if (buf_pool.page_cleaner_LRU_pending);
+    else if (buf_pool.page_cleaner_idle() && !buf_pool.need_LRU_eviction() &&
+             (!UT_LIST_GET_LEN(buf_pool.flush_list) ||
+              srv_max_dirty_pages_pct_lwm == 0.0))
       my_cond_wait(&buf_pool.do_flush_list, &buf_pool.flush_list_mutex.m_mutex);
     else
       my_cond_timedwait(&buf_pool.do_flush_list,
@@ -2141,6 +2188,21 @@ static os_thread_ret_t DECLARE_THREAD(buf_flush_page_cleaner)(void*)
     else if (srv_shutdown_state > SRV_SHUTDOWN_INITIATED)
       break;
 
+    /* Allow buf_LRU_get_free_block() to request the next batch. */
+    buf_pool.page_cleaner_LRU_pending= false;
+
+    if (buf_pool.need_LRU_eviction())
+    {
+      /* Replenish buf_pool.free up to innodb_lru_scan_depth in the
+      background, so that threads in buf_LRU_get_free_block() will find
+      a block without having to scan, evict or write out pages while
+      holding buf_pool.mutex. If a user thread is already running an
+      LRU batch, this is a no-op. */
+      mysql_mutex_unlock(&buf_pool.flush_list_mutex);
+      buf_flush_lists(srv_LRU_scan_depth, 0);
+      mysql_mutex_lock(&buf_pool.flush_list_mutex);
+    }
+
     const ulint dirty_blocks= UT_LIST_GET_LEN(buf_pool.flush_list);
 
     if (!dirty_blocks)
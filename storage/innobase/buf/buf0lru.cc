@@ -388,6 +388,8 @@ the free list. Even when we flush a page or find a page in LRU scan
 we put it to free list to be used.
 * iteration 0:
   * get a block from the buf_pool.free list, success:done
+    (while the list is shorter than innodb_lru_scan_depth,
+    wake up the page cleaner to replenish it in the background)
   * if buf_pool.try_LRU_scan is set
     * scan LRU up to 100 pages to free a clean block
     * success:retry the free list
@@ -422,6 +424,11 @@ buf_block_t* buf_LRU_get_free_block(bool have_mutex)
 retry:
 	/* If there is a block in the free list, take it */
 	if (buf_block_t* block = buf_LRU_get_free_only()) {
+		/* While the free list is shorter than innodb_lru_scan_depth,
+		let the page cleaner replenish it before it runs empty. */
+		if (buf_pool.need_LRU_eviction()) {
+			buf_pool.page_cleaner_wakeup_LRU();
+		}
 		if (!have_mutex) {
 			mysql_mutex_unlock(&buf_pool.mutex);
 		}
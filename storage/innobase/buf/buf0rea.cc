@@ -754,7 +754,19 @@ void buf_read_recv_pages(ulint space_id, const uint32_t* page_nos, ulint n)
 		}
 
 		for (ulint count = 0; buf_pool.n_pend_reads >= limit; ) {
-			os_thread_sleep(10000);
+			/* Wait for buf_page_read_complete() to signal
+			recv_sys.read_done, instead of polling. */
+			const int64_t sig_count = os_event_reset(
+				recv_sys.read_done);
+			if (buf_pool.n_pend_reads < limit) {
+				break;
+			}
+
+			if (os_event_wait_time_low(recv_sys.read_done, 10000,
+						   sig_count)
+			    != OS_SYNC_TIME_EXCEEDED) {
+				continue;
+			}
 
 			if (!(++count % 1000)) {
 
@@ -893,6 +893,7 @@ static SHOW_VAR innodb_status_variables[]= {
   {"buffer_pool_pages_total",
    &export_vars.innodb_buffer_pool_pages_total, SHOW_SIZE_T},
   {"buffer_pool_pages_LRU_flushed", &buf_lru_flush_page_count, SHOW_SIZE_T},
+  {"buffer_pool_LRU_wakeups", &buf_lru_wakeup_count, SHOW_SIZE_T},
   {"buffer_pool_read_ahead_rnd",
    &export_vars.innodb_buffer_pool_read_ahead_rnd, SHOW_SIZE_T},
   {"buffer_pool_read_ahead",
@@ -2590,6 +2591,7 @@ ha_innobase::ha_innobase(
                           | HA_CAN_TABLES_WITHOUT_ROLLBACK
                           | HA_CAN_ONLINE_BACKUPS
 			  | HA_CONCURRENT_OPTIMIZE
+			  | HA_CAN_COUNT_ROWS
 			  |  (srv_force_primary_key ? HA_REQUIRE_PRIMARY_KEY : 0)
 		  ),
 	m_start_of_scan(),
@@ -3862,7 +3864,7 @@ static int innodb_init_params()
 		srv_use_doublewrite_buf = FALSE;
 	}
 
-#ifdef LINUX_NATIVE_AIO
+#if defined LINUX_NATIVE_AIO || defined HAVE_URING
 #elif !defined _WIN32
 	/* Currently native AIO is supported only on windows and linux
 	and that also when the support is compiled in. In all other
@@ -13910,6 +13912,45 @@ ha_innobase::records_in_range(
 	DBUG_RETURN((ha_rows) n_rows);
 }
 
+/** Count the rows of the table in the read view of the transaction,
+for COUNT(*) without a WHERE condition.
+@return number of rows
+@retval HA_POS_ERROR if the rows should be read through the SQL layer */
+
+ha_rows
+ha_innobase::count_rows()
+{
+	DBUG_ENTER("ha_innobase::count_rows");
+
+	dict_table_t*	table = m_prebuilt->table;
+	dict_index_t*	index = dict_table_get_first_index(table);
+
+	if (!srv_parallel_count_threads
+	    || m_prebuilt->select_lock_type != LOCK_NONE
+	    || table->is_temporary()
+	    || table->no_rollback()
+	    || !table->is_readable()
+	    || !index || index->is_corrupted()) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	update_thd();
+
+	trx_t*	trx = m_prebuilt->trx;
+
+	trx_start_if_not_started(trx, false);
+
+	if (trx->isolation_level > TRX_ISO_READ_UNCOMMITTED) {
+		trx->read_view.open(trx);
+	}
+
+	ulint	n_rows;
+	dberr_t	err = row_count_rows_parallel(
+		index, trx, srv_parallel_count_threads, &n_rows);
+
+	DBUG_RETURN(err == DB_SUCCESS ? n_rows : HA_POS_ERROR);
+}
+
 /*********************************************************************//**
 Gives an UPPER BOUND to the number of rows in a table. This is used in
 filesort.cc.
@@ -15312,6 +15353,16 @@ ha_innobase::referenced_by_foreign_key(void)
 	return(0);
 }
 
+/** Check if the table is the parent or the child of a FOREIGN KEY.
+Like referenced_by_foreign_key(), this does not latch the data dictionary;
+the caller holds a metadata lock on the table.
+@return whether the table has or is referenced by a FOREIGN KEY */
+bool ha_innobase::has_foreign_keys()
+{
+	return !m_prebuilt->table->foreign_set.empty()
+		|| dict_table_is_referenced_by_foreign_key(m_prebuilt->table);
+}
+
 /*******************************************************************//**
 Frees the foreign key create info for a table stored in InnoDB, if it is
 non-NULL. */
@@ -19059,6 +19110,12 @@ static MYSQL_SYSVAR_UINT(purge_threads, srv_n_purge_threads,
   "Number of tasks for purging transaction history",
   NULL, NULL, 4, 1, innodb_purge_threads_MAX, 0);
 
+static MYSQL_SYSVAR_UINT(parallel_count_threads, srv_parallel_count_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of tasks for counting the rows of a table for COUNT(*) without"
+  " WHERE condition (0=read the rows through the SQL layer)",
+  NULL, NULL, 0, 0, 256, 0);
+
 static MYSQL_SYSVAR_ULONG(sync_array_size, srv_sync_array_size,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
   "Size of the mutex/lock wait array.",
@@ -20178,6 +20235,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(monitor_reset),
   MYSQL_SYSVAR(monitor_reset_all),
   MYSQL_SYSVAR(purge_threads),
+  MYSQL_SYSVAR(parallel_count_threads),
   MYSQL_SYSVAR(purge_batch_size),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(background_drop_list_empty),
@@ -184,6 +184,8 @@ class ha_innobase final : public handler
                 const key_range*        max_key,
                 page_range*             pages) override;
 
+	ha_rows count_rows() override;
+
 	ha_rows estimate_rows_upper_bound() override;
 
 	void update_create_info(HA_CREATE_INFO* create_info) override;
@@ -225,6 +227,8 @@ class ha_innobase final : public handler
 
 	uint referenced_by_foreign_key() override;
 
+	bool has_foreign_keys() override;
+
 	void free_foreign_key_create_info(char* str) override;
 
 	uint lock_count(void) const override;
@@ -226,6 +226,17 @@ struct btr_search_t{
 				the same prefix should be indexed in the
 				hash index */
 	/*---------------------- @} */
+	/* @{ Sampling of the hash search hit ratio of this index,
+	not protected by any latch, like hash_analysis */
+	ulint	n_sample_succ;	/*!< number of successful hash searches
+				in the current sample */
+	ulint	n_sample_fail;	/*!< number of failed hash searches
+				in the current sample */
+	ulint	suppressed;	/*!< if nonzero, the adaptive hash index
+				will not be used or built for this index
+				for this many more searches, because
+				the hit ratio of the last sample was poor */
+	/* @} */
 #ifdef UNIV_SEARCH_PERF_STAT
 	ulint	n_hash_succ;	/*!< number of successful hash searches thus
 				far */
@@ -373,6 +384,13 @@ before starting the hash analysis again: this is to save CPU time when there
 is no hope in building a hash index. */
 #define BTR_SEARCH_HASH_ANALYSIS	17
 
+/** Number of hash searches in a sample of the hit ratio of an index */
+#define BTR_SEARCH_SAMPLE_SIZE		4096
+
+/** For how many searches the adaptive hash index will be suppressed
+for an index whose hash searches failed more often than they succeeded */
+#define BTR_SEARCH_SUPPRESS_SEARCHES	(1U << 20)
+
 /** Limit of consecutive searches for trying a search shortcut on the search
 pattern */
 #define BTR_SEARCH_ON_PATTERN_LIMIT	3
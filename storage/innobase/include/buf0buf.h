@@ -897,6 +897,8 @@ class buf_page_t
     init();
     state_= state;
     id_= id;
+    /* Pairs with the acquire fence in buf_pool_t::fix_guess() */
+    std::atomic_thread_fence(std::memory_order_release);
     buf_fix_count_= buf_fix_count;
   }
 
@@ -905,6 +907,8 @@ class buf_page_t
   {
     init();
     id_= id;
+    /* Pairs with the acquire fence in buf_pool_t::fix_guess() */
+    std::atomic_thread_fence(std::memory_order_release);
     buf_fix_count_= buf_fix_count;
   }
 
@@ -958,6 +962,9 @@ class buf_page_t
   }
 
   void fix() { buf_fix_count_++; }
+  /** Increment buf_fix_count, unless it is 0.
+  @return whether the block was buffer-fixed */
+  bool fix_if_fixed() { return buf_fix_count_.add_unless_zero(); }
   uint32_t unfix()
   {
     uint32_t count= buf_fix_count_--;
@@ -1589,6 +1596,40 @@ class buf_pool_t
     return is_block_field(reinterpret_cast<const void*>(block));
   }
 
+  /** Buffer-fix a block that is expected to contain a page, without
+  acquiring the page_hash latch. This only succeeds when the block is
+  already buffer-fixed by some other thread, which prevents it from
+  being evicted or relocated. Hot pages (such as the root pages of
+  indexes) are usually buffer-fixed concurrently by several threads, and
+  this avoids writing to the cache line of their page_hash latch.
+  @param block  block that may contain the page
+  @param id     page identifier
+  @return whether the block was buffer-fixed and contains the page */
+  bool fix_guess(buf_block_t *block, const page_id_t id)
+  {
+    /* buf_pool_t::resize() may free the chunk that the block is in,
+    or the chunks[] that is_uncompressed() reads. Announce ourselves
+    before checking resizing; resize() sets resizing and then waits
+    for us, so either we observe resizing or it observes us. */
+    std::atomic<uint32_t> &guessing=
+      n_guessing[get_rnd_value() % UT_ARR_SIZE(n_guessing)].n;
+    guessing.fetch_add(1);
+    const bool fixed= !resizing && is_uncompressed(block) &&
+      block->page.fix_if_fixed();
+    guessing.fetch_sub(1, std::memory_order_release);
+    if (!fixed)
+      return false;
+    /* Our buffer-fix prevents the block from being freed and reused.
+    We observe at least the id() that was assigned together with
+    buf_fix_count in buf_page_t::init(). A block in BUF_BLOCK_FILE_PAGE
+    state has been (or is being) inserted to page_hash for its id(). */
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (block->page.state() == BUF_BLOCK_FILE_PAGE && block->page.id() == id)
+      return true;
+    block->page.unfix();
+    return false;
+  }
+
   /** Get the page_hash latch for a page */
   page_hash_latch *hash_lock_get(const page_id_t id) const
   {
@@ -1951,6 +1992,9 @@ class buf_pool_t
 public:
   /** signalled to wake up the page_cleaner; protected by flush_list_mutex */
   pthread_cond_t do_flush_list;
+  /** whether page_cleaner_wakeup_LRU() signalled the page cleaner, which
+  has not started its LRU batch yet; modified under flush_list_mutex */
+  Atomic_relaxed<bool> page_cleaner_LRU_pending;
 
   /** @return whether the page cleaner must sleep due to being idle */
   bool page_cleaner_idle() const
@@ -1960,6 +2004,12 @@ class buf_pool_t
   }
   /** Wake up the page cleaner if needed */
   inline void page_cleaner_wakeup();
+  /** Wake up the page cleaner to replenish the free list */
+  void page_cleaner_wakeup_LRU();
+  /** @return whether the free list should be replenished in the background
+  (performs a dirty read of free.count) */
+  bool need_LRU_eviction() const
+  { return UT_LIST_GET_LEN(free) < srv_LRU_scan_depth; }
 
   /** Register whether an explicit wakeup of the page cleaner is needed */
   void page_cleaner_set_idle(bool deep_sleep)
@@ -2109,6 +2159,24 @@ class buf_pool_t
 
   /** whether resize() is in the critical path */
   std::atomic<bool> resizing;
+
+  /** Wait for fix_guess() calls that may have missed resizing */
+  void wait_for_guesses() const
+  {
+    for (const auto &g : n_guessing)
+      while (g.n.load(std::memory_order_acquire))
+        os_thread_yield();
+  }
+
+private:
+  /** Number of fix_guess() calls that are checking a block without
+  holding any latch that resize() acquires. The slots are indexed
+  by get_rnd_value(), to avoid a single contended cache line. */
+  struct guess_slot
+  {
+    alignas(CPU_LEVEL1_DCACHE_LINESIZE) std::atomic<uint32_t> n;
+  };
+  guess_slot n_guessing[IB_N_SLOTS];
 };
 
 /** The InnoDB buffer pool */
@@ -2130,12 +2198,16 @@ inline void page_hash_latch::write_lock()
 inline void buf_page_t::add_buf_fix_count(uint32_t count)
 {
   mysql_mutex_assert_owner(&buf_pool.mutex);
+  /* Pairs with the acquire fence in buf_pool_t::fix_guess() */
+  std::atomic_thread_fence(std::memory_order_release);
   buf_fix_count_+= count;
 }
 
 inline void buf_page_t::set_buf_fix_count(uint32_t count)
 {
   mysql_mutex_assert_owner(&buf_pool.mutex);
+  /* Pairs with the acquire fence in buf_pool_t::fix_guess() */
+  std::atomic_thread_fence(std::memory_order_release);
   buf_fix_count_= count;
 }
 
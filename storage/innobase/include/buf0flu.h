@@ -36,6 +36,9 @@ extern ulint buf_flush_page_count;
 /** Number of pages flushed via LRU. Protected by buf_pool.mutex.
 Also included in buf_flush_page_count. */
 extern ulint buf_lru_flush_page_count;
+/** Number of times the page cleaner was woken up to replenish
+buf_pool.free. Protected by buf_pool.flush_list_mutex. */
+extern ulint buf_lru_wakeup_count;
 
 /** Flag indicating if the page_cleaner is in active state. */
 extern bool buf_page_cleaner_is_active;
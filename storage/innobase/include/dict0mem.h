@@ -2304,6 +2304,12 @@ struct dict_table_t {
 	waiters. */
 	ulong					n_waiting_or_granted_auto_inc_locks;
 
+	/** Number of granted or pending LOCK_S or LOCK_X locks on the
+	table. Intention locks (LOCK_IS, LOCK_IX) can only conflict with
+	these, so when this is 0 they are granted without traversing
+	the locks list. Protected by lock_sys.mutex. */
+	ulint					n_lock_x_or_s;
+
 	/** The transaction that currently holds the the AUTOINC lock on this
 	table. Protected by lock_sys.mutex. */
 	const trx_t*				autoinc_trx;
@@ -209,6 +209,9 @@ struct recv_sys_t
 {
   /** mutex protecting apply_log_recs and page_recv_t::state */
   ib_mutex_t mutex;
+  /** signalled when a page read completes during recovery,
+  so that recv_sys_t::apply() and buf_read_recv_pages() need not poll */
+  os_event_t read_done;
   /** whether we are applying redo log records during crash recovery */
   bool recovery_on;
   /** whether recv_recover_page(), invoked from buf_page_read_complete(),
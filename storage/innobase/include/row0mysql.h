@@ -493,6 +493,22 @@ row_scan_index_for_mysql(
 	ulint*			n_rows)		/*!< out: number of entries
 						seen in the consistent read */
 	MY_ATTRIBUTE((warn_unused_result));
+
+/** Count the rows of a table in the read view of a transaction, by
+splitting the clustered index at the node pointers of the root page
+and counting the ranges in srv_thread_pool.
+@param[in]	index		clustered index
+@param[in,out]	trx		transaction
+@param[in]	n_threads	maximum number of concurrent tasks
+@param[out]	n_rows		number of rows seen in the read view
+@return DB_SUCCESS or error code */
+dberr_t
+row_count_rows_parallel(
+	dict_index_t*	index,
+	trx_t*		trx,
+	ulint		n_threads,
+	ulint*		n_rows)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
 /*********************************************************************//**
 Initialize this module */
 void
@@ -456,6 +456,10 @@ extern ulint	srv_dml_needed_delay;
 /** innodb_purge_threads; the number of purge tasks to use */
 extern uint srv_n_purge_threads;
 
+/** innodb_parallel_count_threads; the number of tasks for counting
+the rows of a table (0=read the rows through the SQL layer) */
+extern uint srv_parallel_count_threads;
+
 /* the number of pages to purge in one batch */
 extern ulong srv_purge_batch_size;
 
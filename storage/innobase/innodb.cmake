@@ -63,6 +63,11 @@ IF(UNIX)
       ADD_DEFINITIONS(-DLINUX_NATIVE_AIO=1)
       LINK_LIBRARIES(aio)
     ENDIF()
+    # The tpool library prefers io_uring over libaio when it is available
+    FIND_PACKAGE(URING QUIET)
+    IF(URING_FOUND)
+      ADD_DEFINITIONS(-DHAVE_URING=1)
+    ENDIF()
     IF(HAVE_LIBNUMA)
       LINK_LIBRARIES(numa)
     ENDIF()
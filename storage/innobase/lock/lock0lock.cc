@@ -3362,8 +3362,14 @@ lock_table_create(
 	ut_ad(trx->is_recovered || trx->state == TRX_STATE_ACTIVE);
 	ut_ad(!trx->auto_commit || trx->will_lock);
 
-	if ((type_mode & LOCK_MODE_MASK) == LOCK_AUTO_INC) {
+	switch (LOCK_MODE_MASK & type_mode) {
+	case LOCK_AUTO_INC:
 		++table->n_waiting_or_granted_auto_inc_locks;
+		break;
+	case LOCK_S:
+	case LOCK_X:
+		++table->n_lock_x_or_s;
+		break;
 	}
 
 	/* For AUTOINC locking we reuse the lock instance only if
@@ -3541,6 +3547,16 @@ lock_table_remove_low(
 	trx = lock->trx;
 	table = lock->un_member.tab_lock.table;
 
+	switch (lock_get_mode(lock)) {
+	case LOCK_S:
+	case LOCK_X:
+		ut_ad(table->n_lock_x_or_s);
+		table->n_lock_x_or_s--;
+		break;
+	default:
+		break;
+	}
+
 	/* Remove the table from the transaction's AUTOINC vector, if
 	the lock that is being released is an AUTOINC lock. */
 	if (lock_get_mode(lock) == LOCK_AUTO_INC) {
@@ -3682,6 +3698,20 @@ lock_table_other_has_incompatible(
 
 	ut_ad(lock_mutex_own());
 
+	/* Intention locks are compatible with each other and with
+	LOCK_AUTO_INC; skip the scan of a long queue of such locks. */
+	if ((mode == LOCK_IS || mode == LOCK_IX)
+	    && !table->n_lock_x_or_s) {
+#ifdef UNIV_DEBUG
+		for (lock = UT_LIST_GET_FIRST(table->locks); lock;
+		     lock = UT_LIST_GET_NEXT(un_member.tab_lock.locks, lock)) {
+			ut_ad(lock_get_mode(lock) != LOCK_S);
+			ut_ad(lock_get_mode(lock) != LOCK_X);
+		}
+#endif /* UNIV_DEBUG */
+		return(NULL);
+	}
+
 	for (lock = UT_LIST_GET_LAST(table->locks);
 	     lock != NULL;
 	     lock = UT_LIST_GET_PREV(un_member.tab_lock.locks, lock)) {
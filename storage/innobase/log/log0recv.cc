@@ -942,6 +942,7 @@ void recv_sys_t::close()
 
     last_stored_lsn= 0;
     mutex_free(&mutex);
+    os_event_destroy(read_done);
   }
 
   recv_spaces.clear();
@@ -957,6 +958,7 @@ void recv_sys_t::create()
 	ut_ad(this == &recv_sys);
 	ut_ad(!is_initialised());
 	mutex_create(LATCH_ID_RECV_SYS, &mutex);
+	read_done = os_event_create(0);
 
 	apply_log_recs = false;
 	apply_batch_on = false;
@@ -2726,8 +2728,14 @@ void recv_sys_t::apply(bool last_batch)
     buf_pool.free_block(free_block);
 
     /* Wait until all the pages have been processed */
-    while (!pages.empty() || buf_pool.n_pend_reads)
+    for (;;)
     {
+      /* Reset the event before checking the condition, so that
+      a completion between the check and the wait is not missed. */
+      const int64_t sig_count= os_event_reset(read_done);
+      if (pages.empty() && !buf_pool.n_pend_reads)
+        break;
+
       const bool abort= found_corrupt_log || found_corrupt_fs;
 
       if (found_corrupt_fs && !srv_force_recovery)
@@ -2737,7 +2745,7 @@ void recv_sys_t::apply(bool last_batch)
 
       if (abort)
         return;
-      os_thread_sleep(500000);
+      os_event_wait_time_low(read_done, 500000, sig_count);
       mutex_enter(&mutex);
     }
   }
@@ -350,6 +350,38 @@ struct ReleaseBlocks
   }
 };
 
+/** Insert the blocks that were modified for the first time into
+buf_pool.flush_list. This is executed while holding log_sys.flush_order_mutex
+and buf_pool.flush_list_mutex; the FIL_PAGE_LSN will be assigned
+by ReleaseBlocks after both mutexes have been released. */
+struct InsertFlushList
+{
+  const lsn_t start;
+  InsertFlushList(lsn_t start) : start(start) { ut_ad(start); }
+
+  /** @return true always */
+  bool operator()(mtr_memo_slot_t* slot) const
+  {
+    if (!slot->object)
+      return true;
+    switch (slot->type) {
+    case MTR_MEMO_PAGE_X_MODIFY:
+    case MTR_MEMO_PAGE_SX_MODIFY:
+      break;
+    default:
+      ut_ad(!(slot->type & MTR_MEMO_MODIFY));
+      return true;
+    }
+
+    buf_block_t *block= static_cast<buf_block_t*>(slot->object);
+    /* The same block may be registered in multiple slots. */
+    if (!block->page.oldest_modification() &&
+        !fsp_is_system_temporary(block->page.id().space()))
+      buf_flush_insert_into_flush_list_low(block, start);
+    return true;
+  }
+};
+
 /** Start a mini-transaction. */
 void mtr_t::start()
 {
@@ -410,12 +442,26 @@ void mtr_t::commit()
       lsns= { m_commit_lsn, false };
 
     if (m_made_dirty)
+    {
       mysql_mutex_lock(&log_sys.flush_order_mutex);
-
-    /* It is now safe to release the log mutex because the
-    flush_order mutex will ensure that we are the first one
-    to insert into the flush list. */
-    mysql_mutex_unlock(&log_sys.mutex);
+      /* It is now safe to release the log mutex because the
+      flush_order mutex will ensure that we are the first one
+      to insert into the flush list. */
+      mysql_mutex_unlock(&log_sys.mutex);
+      /* Only insert the newly dirtied blocks while holding the
+      flush_order mutex, with a single acquisition of
+      buf_pool.flush_list_mutex. Everything else is done after
+      releasing the mutexes, while we are still holding the page latches
+      that prevent the blocks from being written out. */
+      mysql_mutex_lock(&buf_pool.flush_list_mutex);
+      m_memo.for_each_block_in_reverse(CIterate<const InsertFlushList>
+                                       (InsertFlushList(lsns.first)));
+      buf_flush_insert_wakeup();
+      mysql_mutex_unlock(&buf_pool.flush_list_mutex);
+      mysql_mutex_unlock(&log_sys.flush_order_mutex);
+    }
+    else
+      mysql_mutex_unlock(&log_sys.mutex);
 
     if (m_freed_pages)
     {
@@ -442,9 +488,6 @@ void mtr_t::commit()
     m_memo.for_each_block_in_reverse(CIterate<const ReleaseBlocks>
                                      (ReleaseBlocks(lsns.first, m_commit_lsn,
                                                     m_memo)));
-    if (m_made_dirty)
-      mysql_mutex_unlock(&log_sys.flush_order_mutex);
-
     m_memo.for_each_block_in_reverse(CIterate<ReleaseLatches>());
 
     if (lsns.second)
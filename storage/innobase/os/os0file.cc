@@ -3737,19 +3737,23 @@ int os_aio_init()
   int max_read_events= int(srv_n_read_io_threads *
                            OS_AIO_N_PENDING_IOS_PER_THREAD);
   int max_events= max_read_events + max_write_events;
-  int ret;
-#if LINUX_NATIVE_AIO
-  if (srv_use_native_aio && !is_linux_native_aio_supported())
-    goto disable;
-#endif
-
-  ret= srv_thread_pool->configure_aio(srv_use_native_aio, max_events);
+  int ret= srv_thread_pool->configure_aio(srv_use_native_aio, max_events);
+
+#if defined LINUX_NATIVE_AIO || defined HAVE_URING
+# ifdef LINUX_NATIVE_AIO
+  /* io_uring (preferred by the thread pool when it is available)
+  works on any file system; libaio needs to be checked for O_DIRECT
+  support on the data and temporary directories. */
+  if (!ret && srv_use_native_aio
+      && srv_thread_pool->get_aio_implementation()
+      != tpool::aio_implementation::IO_URING
+      && !is_linux_native_aio_supported())
+    ret= -1;
+# endif
 
-#ifdef LINUX_NATIVE_AIO
   if (ret)
   {
     ut_ad(srv_use_native_aio);
-disable:
     ib::warn() << "Linux Native AIO disabled.";
     srv_use_native_aio= false;
     ret= srv_thread_pool->configure_aio(false, max_events);
@@ -265,6 +265,24 @@ page_cur_rec_field_extends(
 }
 #endif /* PAGE_CUR_LE_OR_EXTENDS */
 
+/** Prefetch the records that the next step of a binary search in the
+page directory may compare against, so that their cache misses overlap
+with the comparison of the current record.
+@param page  index page
+@param low   lower limit directory slot
+@param mid   directory slot that is about to be compared
+@param up    upper limit directory slot */
+static inline void page_cur_dir_prefetch(const page_t *page,
+                                         ulint low, ulint mid, ulint up)
+{
+  if (mid - low > 1)
+    UNIV_PREFETCH_R(page_dir_slot_get_rec(
+                      page_dir_get_nth_slot(page, (low + mid) / 2)));
+  if (up - mid > 1)
+    UNIV_PREFETCH_R(page_dir_slot_get_rec(
+                      page_dir_get_nth_slot(page, (mid + up) / 2)));
+}
+
 /****************************************************************//**
 Searches the right position for a page cursor. */
 void
@@ -388,6 +406,7 @@ page_cur_search_with_match(
 		mid = (low + up) / 2;
 		slot = page_dir_get_nth_slot(page, mid);
 		mid_rec = page_dir_slot_get_rec(slot);
+		page_cur_dir_prefetch(page, low, mid, up);
 
 		cur_matched_fields = std::min(low_matched_fields,
 					      up_matched_fields);
@@ -635,6 +654,7 @@ page_cur_search_with_match_bytes(
 		mid = (low + up) / 2;
 		slot = page_dir_get_nth_slot(page, mid);
 		mid_rec = page_dir_slot_get_rec(slot);
+		page_cur_dir_prefetch(page, low, mid, up);
 
 		ut_pair_min(&cur_matched_fields, &cur_matched_bytes,
 			    low_matched_fields, low_matched_bytes,
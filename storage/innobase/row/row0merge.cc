@@ -3304,8 +3304,9 @@ row_merge_sort(
 	sol10-64 in buildbot.
 	*/
 #ifndef UNIV_SOLARIS
-	/* Progress report only for "normal" indexes. */
-	if (!(dup->index->type & DICT_FTS)) {
+	/* Progress report only for "normal" indexes,
+	and not from background sort tasks. */
+	if (update_progress && !(dup->index->type & DICT_FTS)) {
 		thd_progress_init(trx->mysql_thd, 1);
 	}
 #endif /* UNIV_SOLARIS */
@@ -3322,7 +3323,7 @@ row_merge_sort(
 		show processlist progress field */
 		/* Progress report only for "normal" indexes. */
 #ifndef UNIV_SOLARIS
-		if (!(dup->index->type & DICT_FTS)) {
+		if (update_progress && !(dup->index->type & DICT_FTS)) {
 			thd_progress_report(trx->mysql_thd, file->offset - num_runs, file->offset);
 		}
 #endif /* UNIV_SOLARIS */
@@ -3352,7 +3353,7 @@ row_merge_sort(
 
 	/* Progress report only for "normal" indexes. */
 #ifndef UNIV_SOLARIS
-	if (!(dup->index->type & DICT_FTS)) {
+	if (update_progress && !(dup->index->type & DICT_FTS)) {
 		thd_progress_end(trx->mysql_thd);
 	}
 #endif /* UNIV_SOLARIS */
@@ -4339,6 +4340,75 @@ row_merge_drop_table(
 			trx, SQLCOM_DROP_TABLE, false, false));
 }
 
+/** Merge sort of the entries of one secondary index, run as a
+thread pool task while the DDL thread sorts and loads other indexes */
+struct row_merge_sort_task_t
+{
+  /** transaction */
+  trx_t *trx;
+  /** descriptor of the index being sorted */
+  row_merge_dup_t dup;
+  /** file containing the index entries */
+  merge_file_t *file;
+  /** tablespace identifier of the new table */
+  ulint space;
+  /** location for the temporary file of the merge, or NULL */
+  const char *path;
+  /** the result of row_merge_sort() */
+  dberr_t error;
+  /** the thread pool task */
+  tpool::waitable_task *task;
+};
+
+/** Sort a merge file in a thread pool task.
+@param arg	row_merge_sort_task_t */
+static void row_merge_sort_task(void *arg)
+{
+  row_merge_sort_task_t *t= static_cast<row_merge_sort_task_t*>(arg);
+  ut_allocator<row_merge_block_t> alloc(mem_key_row_merge_sort);
+  ut_new_pfx_t block_pfx, crypt_pfx;
+  row_merge_block_t *crypt_block= NULL;
+  pfs_os_file_t tmpfd= OS_FILE_CLOSED;
+
+  row_merge_block_t *block= alloc.allocate_large(3 * srv_sort_buf_size,
+                                                 &block_pfx);
+  if (!block)
+  {
+    t->error= DB_OUT_OF_MEMORY;
+    return;
+  }
+
+  if (log_tmp_is_encrypted())
+  {
+    crypt_block= alloc.allocate_large(3 * srv_sort_buf_size, &crypt_pfx);
+    if (!crypt_block)
+    {
+      t->error= DB_OUT_OF_MEMORY;
+      goto func_exit;
+    }
+  }
+
+  /* row_merge() writes each merge pass to tmpfd. The one of the DDL
+  thread cannot be shared, as it is used by the DDL thread meanwhile. */
+  if (!row_merge_tmpfile_if_needed(&tmpfd, t->path))
+  {
+    t->error= DB_OUT_OF_MEMORY;
+    goto free_crypt;
+  }
+
+  /* Progress is only reported by the DDL thread. The index is not
+  unique, so that no duplicate can be reported via dup.table. */
+  t->error= row_merge_sort(t->trx, &t->dup, t->file, block, &tmpfd, false,
+                           0.0, 0.0, crypt_block, t->space);
+
+free_crypt:
+  if (crypt_block)
+    alloc.deallocate_large(crypt_block, &crypt_pfx);
+func_exit:
+  row_merge_file_destroy_low(tmpfd);
+  alloc.deallocate_large(block, &block_pfx);
+}
+
 /** Build indexes on a table by reading a clustered index, creating a temporary
 file containing index entries, merge sorting these index entries and inserting
 sorted index entries to indexes.
@@ -4402,6 +4472,7 @@ row_merge_build_indexes(
 	fts_psort_t*		psort_info = NULL;
 	fts_psort_t*		merge_info = NULL;
 	bool			fts_psort_initiated = false;
+	row_merge_sort_task_t*	sort_tasks = NULL;
 
 	double total_static_cost = 0;
 	double total_dynamic_cost = 0;
@@ -4559,7 +4630,41 @@ row_merge_build_indexes(
 	DEBUG_SYNC_C("row_merge_after_scan");
 
 	/* Now we have files containing index entries ready for
-	sorting and inserting. */
+	sorting and inserting. The first index is sorted by this
+	thread. Sorting the files of subsequent non-unique indexes is
+	started in the thread pool right away, so that they will be
+	sorted while we are sorting and loading the preceding indexes.
+	Unique indexes are sorted by this thread, because a duplicate
+	would be reported via the shared TABLE object. */
+
+	sort_tasks = static_cast<row_merge_sort_task_t*>(
+		ut_zalloc_nokey(n_merge_files * sizeof *sort_tasks));
+
+	for (ulint k = 0, i = 0, n_sort = 0; i < n_indexes; i++) {
+		if (dict_index_is_spatial(indexes[i])) {
+			continue;
+		}
+
+		merge_file_t*	file = &merge_files[k++];
+
+		if ((indexes[i]->type & DICT_FTS)
+		    || file->fd == OS_FILE_CLOSED || !n_sort++
+		    || dict_index_is_unique(indexes[i])) {
+			continue;
+		}
+
+		row_merge_sort_task_t*	t = &sort_tasks[k - 1];
+		t->trx = trx;
+		t->dup.index = indexes[i];
+		t->dup.table = table;
+		t->dup.col_map = col_map;
+		t->file = file;
+		t->space = new_table->space_id;
+		t->path = thd_innodb_tmpdir(trx->mysql_thd);
+		t->error = DB_SUCCESS;
+		t->task = new tpool::waitable_task(row_merge_sort_task, t);
+		srv_thread_pool->submit_task(t->task);
+	}
 
 	for (ulint k = 0, i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
@@ -4568,6 +4673,13 @@ row_merge_build_indexes(
 			continue;
 		}
 
+		if (tpool::waitable_task* task = sort_tasks[k].task) {
+			/* The file was sorted in the background. */
+			task->wait();
+			delete task;
+			sort_tasks[k].task = NULL;
+		}
+
 		if (indexes[i]->type & DICT_FTS) {
 
 			sort_idx = fts_sort_idx;
@@ -4619,12 +4731,16 @@ row_merge_build_indexes(
 						      pct_cost);
 			}
 
-			error = row_merge_sort(
+			if (sort_tasks[k].file) {
+				error = sort_tasks[k].error;
+			} else {
+				error = row_merge_sort(
 					trx, &dup, &merge_files[k],
 					block, &tmpfd, true,
 					pct_progress, pct_cost,
 					crypt_block, new_table->space_id,
 					stage);
+			}
 
 			pct_progress += pct_cost;
 
@@ -4735,6 +4851,19 @@ row_merge_build_indexes(
 		fts_psort_initiated = false;
 	}
 
+	if (sort_tasks) {
+		/* Wait for any sort tasks that were abandoned due to
+		an error, before their files are destroyed. */
+		for (i = 0; i < n_merge_files; i++) {
+			if (tpool::waitable_task* task = sort_tasks[i].task) {
+				task->wait();
+				delete task;
+			}
+		}
+
+		ut_free(sort_tasks);
+	}
+
 	row_merge_file_destroy_low(tmpfd);
 
 	for (i = 0; i < n_merge_files; i++) {
@@ -57,6 +57,7 @@ Created 9/17/2000 Heikki Tuuri
 #include "row0row.h"
 #include "row0sel.h"
 #include "row0upd.h"
+#include "row0vers.h"
 #include "trx0purge.h"
 #include "trx0rec.h"
 #include "trx0roll.h"
@@ -4869,6 +4870,275 @@ row_scan_index_for_mysql(
 	goto loop;
 }
 
+/** State of row_count_rows_parallel() that is shared by the tasks */
+struct row_count_ctx_t
+{
+	/** the clustered index */
+	dict_index_t*			index;
+	/** the transaction that is counting the rows */
+	trx_t*				trx;
+	/** the read view, or NULL for READ UNCOMMITTED */
+	ReadView*			view;
+	/** the start of each range; the first one is NULL (the start
+	of the index), and range i ends where range i + 1 starts */
+	std::vector<const dtuple_t*>	bounds;
+	/** the next range to be counted */
+	Atomic_counter<ulint>		next;
+	/** number of rows seen in the read view */
+	Atomic_counter<ulint>		n_rows;
+	/** the first error that was encountered */
+	std::atomic<dberr_t>		error;
+
+	/** Record an error, unless an error was already reported. */
+	void set_error(dberr_t err)
+	{
+		dberr_t	expected = DB_SUCCESS;
+		error.compare_exchange_strong(expected, err);
+	}
+};
+
+/** Count the rows of one range of the clustered index.
+@param[in,out]	ctx	shared state
+@param[in]	i	range number
+@return error code */
+static dberr_t row_count_range(row_count_ctx_t* ctx, ulint i)
+{
+	dict_index_t*	index = ctx->index;
+	const dtuple_t*	start = ctx->bounds[i];
+	const dtuple_t*	end = i + 1 < ctx->bounds.size()
+		? ctx->bounds[i + 1] : NULL;
+	const ulint	comp = dict_table_is_comp(index->table);
+	mem_heap_t*	heap = NULL;
+	mem_heap_t*	vers_heap = NULL;
+	rec_offs	offsets_[REC_OFFS_NORMAL_SIZE];
+	rec_offs*	offsets = offsets_;
+	ulint		n_rows = 0;
+	btr_pcur_t	pcur;
+	mtr_t		mtr;
+	dberr_t		err;
+
+	rec_offs_init(offsets_);
+	mtr.start();
+
+	err = start
+		? btr_pcur_open(index, start, PAGE_CUR_GE, BTR_SEARCH_LEAF,
+				&pcur, &mtr)
+		: btr_pcur_open_at_index_side(true, index, BTR_SEARCH_LEAF,
+					      &pcur, true, 0, &mtr);
+
+	while (err == DB_SUCCESS) {
+		const rec_t*	rec = btr_pcur_get_rec(&pcur);
+
+		if (!page_rec_is_user_rec(rec)
+		    || rec_is_metadata(rec, *index)) {
+			goto next_rec;
+		}
+
+		offsets = rec_get_offsets(rec, index, offsets,
+					  index->n_core_fields,
+					  ULINT_UNDEFINED, &heap);
+
+		if (end && cmp_dtuple_rec(end, rec, offsets) <= 0) {
+			break;
+		}
+
+		/* A search by PAGE_CUR_GE may end up positioned on
+		the preceding page. Skip any records before the start. */
+		if (start) {
+			if (cmp_dtuple_rec(start, rec, offsets) > 0) {
+				goto next_rec;
+			}
+
+			start = NULL;
+		}
+
+		if (!ctx->view
+		    || lock_clust_rec_cons_read_sees(rec, index, offsets,
+						     ctx->view)) {
+			n_rows += !rec_get_deleted_flag(rec, comp);
+		} else {
+			rec_t*	old_vers;
+
+			if (vers_heap) {
+				mem_heap_empty(vers_heap);
+			} else {
+				vers_heap = mem_heap_create(1024);
+			}
+
+			err = row_vers_build_for_consistent_read(
+				rec, &mtr, index, &offsets, ctx->view,
+				&heap, vers_heap, &old_vers, NULL);
+
+			if (err != DB_SUCCESS) {
+				break;
+			}
+
+			n_rows += old_vers
+				&& !rec_get_deleted_flag(old_vers, comp);
+		}
+next_rec:
+		if (!btr_pcur_is_after_last_on_page(&pcur)) {
+			btr_pcur_move_to_next_on_page(&pcur);
+
+			if (!btr_pcur_is_after_last_on_page(&pcur)) {
+				continue;
+			}
+		}
+
+		/* At the end of the page, release the latches so that
+		the scan of a range will neither accumulate page latches
+		in the mini-transaction nor block page splits and purge
+		for its whole duration. */
+		if (trx_is_interrupted(ctx->trx)) {
+			err = DB_INTERRUPTED;
+			break;
+		}
+
+		if (btr_pcur_is_after_last_in_tree(&pcur)) {
+			break;
+		}
+
+		/* Store the cursor position on the last user record
+		on the page. Leaf pages must never be empty, unless
+		this is the only page in the index tree. */
+		btr_pcur_move_to_prev_on_page(&pcur);
+		ut_ad(btr_pcur_is_on_user_rec(&pcur));
+		btr_pcur_store_position(&pcur, &mtr);
+		mtr.commit();
+		mtr.start();
+		/* Restore the position on the record, or its predecessor
+		if the record was purged meanwhile, and move to the
+		successor of the original record. */
+		btr_pcur_restore_position(BTR_SEARCH_LEAF, &pcur, &mtr);
+
+		if (!btr_pcur_move_to_next_user_rec(&pcur, &mtr)) {
+			break;
+		}
+	}
+
+	btr_pcur_close(&pcur);
+	mtr.commit();
+
+	if (vers_heap) {
+		mem_heap_free(vers_heap);
+	}
+
+	if (heap) {
+		mem_heap_free(heap);
+	}
+
+	ctx->n_rows += n_rows;
+	return(err);
+}
+
+/** Count rows of the clustered index until all ranges have been
+claimed or an error has been reported.
+@param[in,out]	arg	row_count_ctx_t */
+static void row_count_task(void* arg)
+{
+	row_count_ctx_t*	ctx = static_cast<row_count_ctx_t*>(arg);
+
+	for (ulint i; (i = ctx->next++) < ctx->bounds.size(); ) {
+		if (ctx->error != DB_SUCCESS) {
+			return;
+		}
+
+		dberr_t	err = row_count_range(ctx, i);
+
+		if (err != DB_SUCCESS) {
+			ctx->set_error(err);
+			return;
+		}
+	}
+}
+
+/** Count the rows of a table in the read view of a transaction, by
+splitting the clustered index at the node pointers of the root page
+and counting the ranges in srv_thread_pool.
+@param[in]	index		clustered index
+@param[in,out]	trx		transaction
+@param[in]	n_threads	maximum number of concurrent tasks
+@param[out]	n_rows		number of rows seen in the read view
+@return DB_SUCCESS or error code */
+dberr_t
+row_count_rows_parallel(
+	dict_index_t*	index,
+	trx_t*		trx,
+	ulint		n_threads,
+	ulint*		n_rows)
+{
+	ut_ad(index->is_primary());
+	ut_ad(n_threads > 0);
+
+	row_count_ctx_t	ctx;
+	mem_heap_t*	heap = mem_heap_create(1024);
+	mtr_t		mtr;
+
+	ctx.index = index;
+	ctx.trx = trx;
+	ctx.view = trx->isolation_level > TRX_ISO_READ_UNCOMMITTED
+		&& trx->read_view.is_open() ? &trx->read_view : NULL;
+	ctx.next = 0;
+	ctx.n_rows = 0;
+	ctx.error = DB_SUCCESS;
+	ctx.bounds.push_back(NULL);
+
+	mtr.start();
+
+	const buf_block_t*	root = btr_root_block_get(
+		index, RW_S_LATCH, &mtr);
+
+	if (!root) {
+		mtr.commit();
+		mem_heap_free(heap);
+		return(DB_CORRUPTION);
+	}
+
+	if (!page_is_leaf(root->frame)) {
+		const ulint	n_fields
+			= dict_index_get_n_unique_in_tree_nonleaf(index);
+		const rec_t*	rec = page_rec_get_next_const(
+			page_get_infimum_rec(root->frame));
+
+		/* The first node pointer is covered by the range that
+		starts at the beginning of the index. */
+		while (!page_rec_is_supremum(rec)) {
+			rec = page_rec_get_next_const(rec);
+
+			if (page_rec_is_supremum(rec)) {
+				break;
+			}
+
+			ctx.bounds.push_back(dict_index_build_data_tuple(
+				rec, index, false, n_fields, heap));
+		}
+	}
+
+	mtr.commit();
+
+	const ulint	n_tasks = std::min<ulint>(n_threads, ctx.bounds.size());
+	std::vector<tpool::waitable_task*>	tasks;
+
+	for (ulint i = 1; i < n_tasks; i++) {
+		tpool::waitable_task*	task = new tpool::waitable_task(
+			row_count_task, &ctx);
+		tasks.push_back(task);
+		srv_thread_pool->submit_task(task);
+	}
+
+	row_count_task(&ctx);
+
+	for (tpool::waitable_task* task : tasks) {
+		task->wait();
+		delete task;
+	}
+
+	mem_heap_free(heap);
+
+	*n_rows = ctx.n_rows;
+	return(ctx.error);
+}
+
 /*********************************************************************//**
 Initialize this module */
 void
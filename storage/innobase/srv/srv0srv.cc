@@ -272,6 +272,10 @@ ulong	srv_flushing_avg_loops;
 /** innodb_purge_threads; the number of purge tasks to use */
 uint srv_n_purge_threads;
 
+/** innodb_parallel_count_threads; the number of tasks for counting
+the rows of a table (0=read the rows through the SQL layer) */
+uint srv_parallel_count_threads;
+
 /** innodb_purge_batch_size, in pages */
 ulong	srv_purge_batch_size;
 
@@ -25,6 +25,7 @@ Created 3/26/1996 Heikki Tuuri
 *******************************************************/
 
 #include "trx0purge.h"
+#include "dict0dict.h"
 #include "fsp0fsp.h"
 #include "fut0fut.h"
 #include "mach0data.h"
@@ -44,6 +45,7 @@ Created 3/26/1996 Heikki Tuuri
 #include <mysql/service_wsrep.h>
 
 #include <unordered_map>
+#include <vector>
 
 /** Maximum allowable purge history length.  <=0 means 'infinite'. */
 ulong		srv_max_purge_lag = 0;
@@ -1094,6 +1096,147 @@ trx_purge_fetch_next_rec(
 	return(trx_purge_get_next_rec(n_pages_handled, heap));
 }
 
+/** Determine the types of the PRIMARY KEY columns of a table, so that
+its undo log records can be distributed among the purge threads by key.
+@param table_id  table identifier
+@param key       the types of the PRIMARY KEY columns
+@return whether the records can be distributed by key
+@retval false if the table is not in the dictionary cache, or a column
+cannot be folded consistently with its comparison */
+static bool trx_purge_table_key(table_id_t table_id,
+                                std::vector<dtype_t> &key)
+{
+  key.clear();
+  mutex_enter(&dict_sys.mutex);
+  if (const dict_table_t *table= dict_sys.get_table(table_id))
+    if (const dict_index_t *clust= dict_table_get_first_index(table))
+      if (clust->is_primary())
+        for (ulint i= 0; i < dict_index_get_n_unique(clust); i++)
+        {
+          dtype_t type;
+          dict_col_copy_type(dict_index_get_nth_col(clust, i), &type);
+          key.push_back(type);
+        }
+  mutex_exit(&dict_sys.mutex);
+
+  for (const dtype_t &type : key)
+  {
+    switch (type.mtype) {
+    case DATA_DECIMAL:
+    case DATA_DOUBLE:
+    case DATA_FLOAT:
+      /* Values with different bytes, such as 0 and -0, compare equal. */
+      goto not_distributed;
+    case DATA_BLOB:
+      if (type.prtype & DATA_BINARY_TYPE)
+        break;
+      /* fall through */
+    case DATA_VARMYSQL:
+    case DATA_MYSQL:
+      if (!all_charsets[dtype_get_charset_coll(type.prtype)])
+        goto not_distributed;
+    }
+  }
+  return !key.empty();
+not_distributed:
+  key.clear();
+  return false;
+}
+
+/** Compute a fold value of a PRIMARY KEY column that is equal for all
+values that compare equal, for example 'a' and 'A ' in a case-insensitive
+collation that ignores trailing spaces.
+@param type  data type of the column
+@param data  the value
+@param len   length of the value, or UNIV_SQL_NULL
+@return fold value */
+static ulint trx_purge_col_fold(const dtype_t &type, const byte *data,
+                                ulint len)
+{
+  if (len == UNIV_SQL_NULL)
+    return 0;
+
+  const CHARSET_INFO *cs;
+
+  switch (type.mtype) {
+  case DATA_FIXBINARY:
+  case DATA_BINARY:
+    if (dtype_get_charset_coll(type.prtype) !=
+        DATA_MYSQL_BINARY_CHARSET_COLL)
+      /* Trailing spaces are ignored in comparisons. */
+      while (len && data[len - 1] == 0x20)
+        len--;
+    /* fall through */
+  default:
+    return ut_fold_binary(data, len);
+  case DATA_BLOB:
+    if (type.prtype & DATA_BINARY_TYPE)
+      return ut_fold_binary(data, len);
+    /* fall through */
+  case DATA_VARMYSQL:
+  case DATA_MYSQL:
+    cs= all_charsets[dtype_get_charset_coll(type.prtype)];
+    break;
+  case DATA_VARCHAR:
+  case DATA_CHAR:
+    cs= &my_charset_latin1;
+    break;
+  }
+
+  ulong nr1= 1, nr2= 4;
+  my_ci_hash_sort(cs, data, len, &nr1, &nr2);
+  return nr1;
+}
+
+/** Compute a fold value of the PRIMARY KEY in an undo log record.
+All undo log records of the same row are assigned to the same purge
+thread, so that they will be processed in order.
+@param undo_rec  undo log record
+@param key       the types of the PRIMARY KEY columns
+@param fold      fold value of the PRIMARY KEY
+@return whether the fold value was computed
+@retval false if all records of the table must be processed by
+a single purge thread */
+static bool trx_purge_rec_fold(trx_undo_rec_t *undo_rec,
+                               const std::vector<dtype_t> &key, ulint *fold)
+{
+  ulint type, cmpl_info;
+  bool updated_extern;
+  undo_no_t undo_no;
+  table_id_t table_id;
+  const byte *ptr= trx_undo_rec_get_pars(undo_rec, &type, &cmpl_info,
+                                         &updated_extern, &undo_no,
+                                         &table_id);
+  switch (type) {
+  case TRX_UNDO_UPD_EXIST_REC:
+  case TRX_UNDO_UPD_DEL_REC:
+  case TRX_UNDO_DEL_MARK_REC:
+    trx_id_t trx_id;
+    roll_ptr_t roll_ptr;
+    byte info_bits;
+    ptr= trx_undo_update_rec_get_sys_cols(ptr, &trx_id, &roll_ptr,
+                                          &info_bits);
+    /* The metadata record of instant ALTER TABLE affects all rows. */
+    if (info_bits & REC_INFO_MIN_REC_FLAG)
+      return false;
+    /* fall through */
+  case TRX_UNDO_INSERT_REC:
+    break;
+  default:
+    return false;
+  }
+
+  *fold= 0;
+  for (const dtype_t &col : key)
+  {
+    const byte *field;
+    uint32_t len, orig_len;
+    ptr= trx_undo_rec_get_col_val(ptr, &field, &len, &orig_len);
+    *fold= ut_fold_ulint_pair(*fold, trx_purge_col_fold(col, field, len));
+  }
+  return true;
+}
+
 /** Run a purge batch.
 @param n_purge_threads	number of purge threads
 @return number of undo log pages handled in the batch */
@@ -1138,24 +1281,25 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 	thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
 	ut_a(n_thrs > 0 && thr != NULL);
 
-	ut_ad(purge_sys.head <= purge_sys.tail);
+	std::vector<purge_node_t*> nodes;
+	nodes.reserve(n_purge_threads);
+	for (i = 0; i < n_purge_threads; i++) {
+		ut_a(thr != NULL);
+		ut_a(!thr->is_active);
+		ut_a(que_node_get_type(thr->child) == QUE_NODE_PURGE);
+		nodes.push_back(static_cast<purge_node_t*>(thr->child));
+		thr = UT_LIST_GET_NEXT(thrs, thr);
+	}
 
-	i = 0;
+	ut_ad(purge_sys.head <= purge_sys.tail);
 
 	const ulint		batch_size = srv_purge_batch_size;
-	std::unordered_map<table_id_t, purge_node_t*> table_id_map;
+	std::vector<trx_purge_rec_t> recs;
 	mem_heap_empty(purge_sys.heap);
 
 	while (UNIV_LIKELY(srv_undo_sources) || !srv_fast_shutdown) {
-		purge_node_t*		node;
 		trx_purge_rec_t		purge_rec;
 
-		ut_a(!thr->is_active);
-
-		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
-		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
-
 		/* Track the max {trx_id, undo_no} for truncating the
 		UNDO logs once we have purged the records. */
 
@@ -1174,33 +1318,76 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 			continue;
 		}
 
-		table_id_t table_id = trx_undo_rec_get_table_id(
-			purge_rec.undo_rec);
+		recs.push_back(purge_rec);
 
-		purge_node_t *& table_node = table_id_map[table_id];
+		if (n_pages_handled >= batch_size) {
+			break;
+		}
+	}
 
-		if (table_node) {
-			node = table_node;
-		} else {
-			thr = UT_LIST_GET_NEXT(thrs, thr);
+	ut_ad(purge_sys.head <= purge_sys.tail);
 
-			if (!(++i % n_purge_threads)) {
-				thr = UT_LIST_GET_FIRST(
-					purge_sys.query->thrs);
+	/* Records of the same table used to be processed by a single
+	purge node, which made the purge of a single table with a long
+	history single-threaded. If the PRIMARY KEY of every record of
+	a table can be determined, the records are distributed by the
+	PRIMARY KEY instead, so that all versions of a row will still be
+	processed by the same purge node, in order. */
+	struct purge_table_t {
+		/** the purge node, or NULL if distributed by key */
+		purge_node_t*	node;
+		/** the types of the PRIMARY KEY columns,
+		or empty if not distributed by key */
+		std::vector<dtype_t>	key;
+	};
+	std::unordered_map<table_id_t, purge_table_t> table_id_map;
+
+	if (n_purge_threads > 1) {
+		for (const trx_purge_rec_t& purge_rec : recs) {
+			const table_id_t table_id = trx_undo_rec_get_table_id(
+				purge_rec.undo_rec);
+			auto r = table_id_map.emplace(
+				table_id, purge_table_t());
+			purge_table_t& t = r.first->second;
+			ulint fold;
+
+			if (r.second) {
+				trx_purge_table_key(table_id, t.key);
 			}
 
-			ut_a(thr != NULL);
-			table_node = node;
+			if (!t.key.empty()
+			    && !trx_purge_rec_fold(purge_rec.undo_rec,
+						   t.key, &fold)) {
+				t.key.clear();
+			}
 		}
+	}
 
-		node->undo_recs.push(purge_rec);
+	i = 0;
 
-		if (n_pages_handled >= batch_size) {
-			break;
+	for (const trx_purge_rec_t& purge_rec : recs) {
+		const table_id_t table_id = trx_undo_rec_get_table_id(
+			purge_rec.undo_rec);
+		purge_table_t& t = table_id_map.emplace(
+			table_id, purge_table_t()).first->second;
+		purge_node_t* node;
+		ulint fold;
+
+		if (!t.key.empty()) {
+			ut_d(bool ok =)
+			trx_purge_rec_fold(purge_rec.undo_rec, t.key,
+					   &fold);
+			ut_ad(ok);
+			node = nodes[fold % n_purge_threads];
+		} else {
+			if (!t.node) {
+				t.node = nodes[i++ % n_purge_threads];
+			}
+			node = t.node;
 		}
-	}
 
-	ut_ad(purge_sys.head <= purge_sys.tail);
+		node->undo_recs.push(purge_rec);
+	}
 
 	return(n_pages_handled);
 }
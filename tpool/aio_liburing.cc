@@ -0,0 +1,275 @@
+/* Copyright (C) 2021, MariaDB Corporation.
+
+This program is free software; you can redistribute itand /or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02111 - 1301 USA*/
+
+#include "tpool_structs.h"
+#include "tpool.h"
+
+#include <liburing.h>
+
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+  Linux AIO implementation, based on io_uring.
+  Needs liburing.h and -luring at the compile time.
+
+  Submission and completion queues are shared with the kernel,
+  so no system call is needed to collect completions that are
+  already available. Requests that arrive while another thread is
+  submitting are queued, and that thread submits them together,
+  with one io_uring_enter() per batch.
+
+  A single thread waits for completions, reaps them in batches
+  and forwards io completion callback to the worker threadpool.
+*/
+namespace tpool
+{
+
+class aio_uring final : public aio
+{
+  thread_pool *m_pool;
+  io_uring m_uring;
+  /** Protects the submission queue and m_batch;
+  liburing itself is not thread-safe */
+  std::mutex m_sq_mutex;
+  /** Requests being copied to the submission queue */
+  std::vector<aiocb*> m_batch;
+  /** Protects m_pending and m_submitting */
+  std::mutex m_pending_mutex;
+  /** Requests waiting for the submitting thread */
+  std::vector<aiocb*> m_pending;
+  /** Whether a thread is submitting the m_pending requests */
+  bool m_submitting= false;
+  std::thread m_thread;
+
+  /** Forward a completion to the thread pool */
+  void complete(io_uring_cqe *cqe)
+  {
+    aiocb *iocb= static_cast<aiocb*>(io_uring_cqe_get_data(cqe));
+    if (cqe->res < 0)
+    {
+      iocb->m_err= -cqe->res;
+      iocb->m_ret_len= 0;
+    }
+    else
+    {
+      iocb->m_ret_len= cqe->res;
+      iocb->m_err= 0;
+    }
+    iocb->m_internal_task.m_func= iocb->m_callback;
+    iocb->m_internal_task.m_arg= iocb;
+    iocb->m_internal_task.m_group= iocb->m_group;
+    m_pool->submit_task(&iocb->m_internal_task);
+  }
+
+  static void thread_routine(aio_uring *aio)
+  {
+    /*
+      We collect events in small batches, so that the completion
+      queue head is advanced once per batch.
+    */
+    constexpr unsigned MAX_EVENTS= 256;
+    io_uring_cqe *cqes[MAX_EVENTS];
+
+    for (;;)
+    {
+      io_uring_cqe *cqe;
+      if (int ret= io_uring_wait_cqe(&aio->m_uring, &cqe))
+      {
+        if (ret == -EINTR)
+          continue;
+        fprintf(stderr, "io_uring_wait_cqe() returned %d\n", ret);
+        abort();
+      }
+
+      unsigned n= io_uring_peek_batch_cqe(&aio->m_uring, cqes, MAX_EVENTS);
+      bool shutdown= false;
+      for (unsigned i= 0; i < n; i++)
+      {
+        /* A nop without user data is submitted by ~aio_uring() */
+        if (!io_uring_cqe_get_data(cqes[i]))
+          shutdown= true;
+        else
+          aio->complete(cqes[i]);
+      }
+      io_uring_cq_advance(&aio->m_uring, n);
+      if (shutdown)
+        return;
+    }
+  }
+
+  /** Pass the requests in m_batch to the kernel, with one
+  io_uring_submit() unless the submission queue fills up */
+  void submit_batch()
+  {
+    for (aiocb *cb : m_batch)
+    {
+      io_uring_sqe *sqe= io_uring_get_sqe(&m_uring);
+      if (!sqe)
+      {
+        /* The queue is as large as the maximum number of pending
+        requests, and the kernel consumes all of it on submission;
+        still, make room rather than lose a request. */
+        submit();
+        sqe= io_uring_get_sqe(&m_uring);
+        if (!sqe)
+        {
+          fprintf(stderr, "io_uring_get_sqe() failed\n");
+          abort();
+        }
+      }
+      if (cb->m_opcode == aio_opcode::AIO_PREAD)
+        io_uring_prep_read(sqe, cb->m_fh, cb->m_buffer, cb->m_len,
+                           cb->m_offset);
+      else
+        io_uring_prep_write(sqe, cb->m_fh, cb->m_buffer, cb->m_len,
+                            cb->m_offset);
+      io_uring_sqe_set_data(sqe, cb);
+    }
+    m_batch.clear();
+    submit();
+  }
+
+  /** Submit the prepared entries of the submission queue */
+  void submit()
+  {
+    for (;;)
+    {
+      int ret= io_uring_submit(&m_uring);
+      if (ret >= 0)
+        return;
+      /* -EBUSY means that the completion queue overflowed; the
+      completion thread will make room. */
+      if (ret != -EINTR && ret != -EAGAIN && ret != -EBUSY)
+      {
+        fprintf(stderr, "io_uring_submit() returned %d\n", ret);
+        abort();
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  /** Check that the kernel implements the operations that we need.
+  @return whether IORING_OP_READ and IORING_OP_WRITE are supported */
+  bool probe()
+  {
+    io_uring_probe *p= io_uring_get_probe_ring(&m_uring);
+    if (!p)
+      return false;
+    bool ok= io_uring_opcode_supported(p, IORING_OP_READ) &&
+      io_uring_opcode_supported(p, IORING_OP_WRITE);
+    free(p);
+    return ok;
+  }
+
+public:
+  aio_uring(thread_pool *pool) : m_pool(pool) {}
+
+  /** Set up the rings and start the completion thread.
+  @param max_io  maximum number of outstanding requests
+  @return error code
+  @retval 0 on success */
+  int init(int max_io)
+  {
+    if (int ret= io_uring_queue_init(max_io, &m_uring, 0))
+      return ret;
+    /* Avoid allocating memory while submitting. */
+    m_batch.reserve(max_io);
+    m_pending.reserve(max_io);
+    if (!probe())
+    {
+      io_uring_queue_exit(&m_uring);
+      return -ENOSYS;
+    }
+    /* Do not let a fork()ed child process share the rings. */
+    if (int ret= io_uring_ring_dontfork(&m_uring))
+    {
+      io_uring_queue_exit(&m_uring);
+      return ret;
+    }
+    m_thread= std::thread(thread_routine, this);
+    return 0;
+  }
+
+  ~aio_uring()
+  {
+    if (!m_thread.joinable())
+      return; /* init() failed */
+    {
+      std::lock_guard<std::mutex> lk(m_sq_mutex);
+      io_uring_sqe *sqe= io_uring_get_sqe(&m_uring);
+      io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, nullptr);
+      int ret= io_uring_submit(&m_uring);
+      if (ret != 1)
+      {
+        fprintf(stderr, "io_uring_submit() returned %d\n", ret);
+        abort();
+      }
+    }
+    m_thread.join();
+    io_uring_queue_exit(&m_uring);
+  }
+
+  int submit_io(aiocb *cb) override
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_pending_mutex);
+      m_pending.push_back(cb);
+      if (m_submitting)
+        return 0; /* The submitting thread will pick up the request. */
+      m_submitting= true;
+    }
+
+    std::lock_guard<std::mutex> lk(m_sq_mutex);
+    for (;;)
+    {
+      {
+        std::lock_guard<std::mutex> pk(m_pending_mutex);
+        if (m_pending.empty())
+        {
+          m_submitting= false;
+          return 0;
+        }
+        m_batch.swap(m_pending);
+      }
+      submit_batch();
+    }
+  }
+
+  int bind(native_file_handle&) override { return 0; }
+  int unbind(const native_file_handle&) override { return 0; }
+  const char *name() const override { return "io_uring"; }
+  aio_implementation implementation() const override
+  { return aio_implementation::IO_URING; }
+};
+
+aio *create_linux_uring(thread_pool *pool, int max_io)
+{
+  aio_uring *aio= new aio_uring(pool);
+  if (int ret= aio->init(max_io))
+  {
+    fprintf(stderr, "io_uring_queue_init(%d) returned %d\n", max_io, ret);
+    delete aio;
+    return nullptr;
+  }
+  return aio;
+}
+}
@@ -172,6 +172,9 @@ class aio_linux final : public aio
 
   int bind(native_file_handle&) override { return 0; }
   int unbind(const native_file_handle&) override { return 0; }
+  const char *name() const override { return "Linux native AIO"; }
+  aio_implementation implementation() const override
+  { return aio_implementation::LIBAIO; }
 };
 
 std::atomic<bool> aio_linux::shutdown_in_progress;
@@ -173,6 +173,9 @@ class simulated_aio : public aio
 
   virtual int bind(native_file_handle &fd) override { return 0; }
   virtual int unbind(const native_file_handle &fd) override { return 0; }
+  const char *name() const override { return "simulated AIO"; }
+  aio_implementation implementation() const override
+  { return aio_implementation::SIMULATED; }
 };
 
 aio *create_simulated_aio(thread_pool *tp)
@@ -129,6 +129,9 @@ class tpool_generic_win_aio : public aio
       : GetLastError();
   }
   virtual int unbind(const native_file_handle& fd) override { return 0; }
+  const char *name() const override { return "Windows native AIO"; }
+  aio_implementation implementation() const override
+  { return aio_implementation::WIN; }
 };
 
 aio* create_win_aio(thread_pool* pool, int max_io)
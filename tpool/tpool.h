@@ -149,6 +149,15 @@ struct aiocb
 };
 
 
+/** AIO implementations */
+enum class aio_implementation
+{
+  SIMULATED,
+  LIBAIO,
+  IO_URING,
+  WIN
+};
+
 /**
  AIO interface
 */
@@ -164,6 +173,10 @@ class aio
   virtual int bind(native_file_handle &fd)= 0;
   /** "Unind" file to AIO handler (used on Windows only) */
   virtual int unbind(const native_file_handle &fd)= 0;
+  /** @return name of the implementation, for diagnostics */
+  virtual const char *name() const= 0;
+  /** @return the implementation */
+  virtual aio_implementation implementation() const= 0;
   virtual ~aio(){};
 };
 
@@ -230,6 +243,12 @@ class thread_pool
   }
   int bind(native_file_handle &fd) { return m_aio->bind(fd); }
   void unbind(const native_file_handle &fd) { if (m_aio) m_aio->unbind(fd); }
+  /** @return name of the configured AIO implementation */
+  const char *aio_name() const { return m_aio ? m_aio->name() : nullptr; }
+  /** @return the configured AIO implementation; configure_aio() must
+  have succeeded */
+  aio_implementation get_aio_implementation() const
+  { return m_aio->implementation(); }
   int submit_io(aiocb *cb) { return m_aio->submit_io(cb); }
   virtual void wait_begin() {};
   virtual void wait_end() {};
@@ -39,6 +39,9 @@ namespace tpool
 
 #ifdef __linux__
   extern aio* create_linux_aio(thread_pool* tp, int max_io);
+# ifdef HAVE_URING
+  extern aio* create_linux_uring(thread_pool* tp, int max_io);
+# endif
 #endif
 #ifdef _WIN32
   extern aio* create_win_aio(thread_pool* tp, int max_io);
@@ -278,6 +281,14 @@ class thread_pool_generic : public thread_pool
 #ifdef _WIN32
     return create_win_aio(this, max_io);
 #elif defined(__linux__)
+# ifdef HAVE_URING
+    /*
+      Prefer io_uring. It may be unavailable at runtime (old kernel,
+      or blocked by seccomp), in which case we fall back to libaio.
+    */
+    if (aio *a= create_linux_uring(this, max_io))
+      return a;
+# endif
     return create_linux_aio(this,max_io);
 #else
     return nullptr;
@@ -210,6 +210,10 @@ class thread_pool_win : public thread_pool
         CloseThreadpoolIo(fd.m_ptp_io);
       return 0;
     }
+
+    const char *name() const override { return "Windows native AIO"; }
+    aio_implementation implementation() const override
+    { return aio_implementation::WIN; }
   };
 
   PTP_POOL m_ptp_pool;
@@ -0,0 +1,99 @@
+/* Copyright (c) 2021, MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <my_rnd.h>
+#include "tap.h"
+
+#define MAX_KEYS 5000
+#define MAX_SIZE 40
+
+static uchar keys[MAX_KEYS * MAX_SIZE];
+static uchar *ptrs[MAX_KEYS], *buffer[MAX_KEYS];
+static struct my_rnd_struct rand_st;
+
+/*
+  Fill n keys of the given size. The first prefix bytes are the same in
+  all keys, and the remaining bytes take one of distinct values, so that
+  a small value of distinct produces many equal keys.
+*/
+static void fill(uint n, size_t size, size_t prefix, uint distinct)
+{
+  uint i;
+  size_t j;
+  for (i= 0; i < n; i++)
+  {
+    uchar *key= keys + i * size;
+    uint v= (uint) (my_rnd(&rand_st) * distinct);
+    for (j= 0; j < size; j++)
+      key[j]= j < prefix ? 0xa5 : (uchar) (v >> (8 * ((size - 1 - j) % 4)));
+    ptrs[i]= key;
+  }
+}
+
+/*
+  Check that the keys are in ascending order, and that equal keys are
+  in their original order, which is the order of their addresses.
+*/
+static my_bool is_sorted(uint n, size_t size)
+{
+  uint i;
+  for (i= 1; i < n; i++)
+  {
+    int cmp= memcmp(ptrs[i - 1], ptrs[i], size);
+    if (cmp > 0 || (cmp == 0 && ptrs[i - 1] > ptrs[i]))
+      return FALSE;
+  }
+  return TRUE;
+}
+
+static void test_sort(uint n, size_t size, size_t prefix, uint distinct)
+{
+  fill(n, size, prefix, distinct);
+  radixsort_msd_for_str_ptr(ptrs, n, size, buffer);
+  ok(is_sorted(n, size), "n=%u size=%u prefix=%u distinct=%u",
+     n, (uint) size, (uint) prefix, distinct);
+}
+
+int main(int argc __attribute__((unused)), char *argv[])
+{
+  static const uint sizes[]= { 1, 2, 5, 8, 20, MAX_SIZE };
+  static const uint counts[]= { 0, 1, 2, 15, 16, 17, 100, MAX_KEYS };
+  uint i, j;
+  MY_INIT(argv[0]);
+  my_rnd_init(&rand_st, 1, 2);
+
+  plan(array_elements(sizes) * array_elements(counts) * 3 + 3);
+
+  for (i= 0; i < array_elements(sizes); i++)
+    for (j= 0; j < array_elements(counts); j++)
+    {
+      /* Distinct keys */
+      test_sort(counts[j], sizes[i], 0, 1U << 30);
+      /* Many duplicates */
+      test_sort(counts[j], sizes[i], 0, 3);
+      /* A long common prefix */
+      test_sort(counts[j], sizes[i], sizes[i] - 1, 256);
+    }
+
+  /* All keys are equal */
+  test_sort(MAX_KEYS, 8, 8, 1);
+  test_sort(MAX_KEYS, 8, 0, 1);
+  test_sort(17, MAX_SIZE, MAX_SIZE, 1);
+
+  my_end(0);
+  return exit_status();
+}